@@ -12,7 +12,15 @@
 
 #include "fps.h"
 #include "timer.h"
+#include "task.h"
+#include "timing_wheel.h"
+#include "cpu_topology.h"
+#include "histogram.h"
 #include "thread_pool.h"
+#include "parallel.h"
+#include "task_graph.h"
+#include "task_group.h"
+#include "coroutine.h"
 #include "numerics.h"
 
 #include "window.h"
@@ -21,7 +29,15 @@
 
 #include "fps.inl"
 #include "timer.inl"
+#include "task.inl"
+#include "timing_wheel.inl"
+#include "cpu_topology.inl"
+#include "histogram.inl"
 #include "thread_pool.inl"
+#include "parallel.inl"
+#include "task_graph.inl"
+#include "task_group.inl"
+#include "coroutine.inl"
 #include "numerics.inl"
 
 #include "window.inl"
@@ -0,0 +1,455 @@
+/**
+ * @file	thread_pool_bench.cpp
+ * @brief	HiCxx ̳߳صĻ׼
+ * @author	
+ * @note	 Windows.h, ֱӰ̳߳صͷļ, :
+ *			g++ -std=c++20 -O2 -pthread -I.. thread_pool_bench.cpp
+ *			÷: thread_pool_bench [|all] [߳], ߳ 1 ʼ 2 ɨ赽߳;
+ *			ÿһ ",=ֵ,..." ڽűȽ
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <random>
+#include <mutex>
+#include <condition_variable>
+
+#include "../task.h"
+#include "../timing_wheel.h"
+#include "../cpu_topology.h"
+#include "../histogram.h"
+#include "../thread_pool.h"
+
+#include "../task.inl"
+#include "../timing_wheel.inl"
+#include "../cpu_topology.inl"
+#include "../histogram.inl"
+#include "../thread_pool.inl"
+
+namespace
+{
+	using PoolT		= HiCxx::thread_pool<2>;
+	using ClockT	= ::std::chrono::steady_clock;
+
+	double get_ms(ClockT::duration duration) noexcept
+	{
+		return ::std::chrono::duration<double, ::std::milli>(duration).count();
+	}
+
+	double get_cpu_ms(::std::clock_t begin, ::std::clock_t end) noexcept
+	{
+		return 1000.0 * (double)(end - begin) / CLOCKS_PER_SEC;
+	}
+
+	double get_percentile(::std::vector<double>& samples, double percent) noexcept
+	{
+		if (samples.empty())
+			return 0.0;
+		const size_t index = (size_t)(percent / 100.0 * (double)(samples.size() - 1));
+		::std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+		return samples[index];
+	}
+
+	::std::vector<int> get_threads_sweep(int max_threads_num) noexcept
+	{
+		::std::vector<int> sweep;
+		for (int threads_num = 1; threads_num < max_threads_num; threads_num *= 2)
+			sweep.push_back(threads_num);
+		sweep.push_back(max_threads_num);
+		return sweep;
+	}
+
+	void print_latency(const char* name, const char* params, ::std::vector<double>& samples_us) noexcept
+	{
+		const double p50 = get_percentile(samples_us, 50.0);
+		const double p90 = get_percentile(samples_us, 90.0);
+		const double p99 = get_percentile(samples_us, 99.0);
+		const double max = get_percentile(samples_us, 100.0);
+		::printf("%s,%s,samples=%zu,p50_us=%.3f,p90_us=%.3f,p99_us=%.3f,max_us=%.3f\n", name, params, samples_us.size(), p50, p90, p99, max);
+	}
+
+	/**
+	 * @brief	һڼ pause, ͳƵȴڼĵ CPU ʱ
+	*/
+	void bench_pause_idle(int threads_num, int task_ms) noexcept
+	{
+		PoolT pool;
+		pool.set_multi(true);
+		pool.start(threads_num);
+		pool.post([task_ms]() { ::std::this_thread::sleep_for(::std::chrono::milliseconds(task_ms)); });
+		::std::this_thread::sleep_for(::std::chrono::milliseconds(10));
+
+		const auto wall_begin = ClockT::now();
+		const ::std::clock_t cpu_begin = ::std::clock();
+		pool.pause();
+		const ::std::clock_t cpu_end = ::std::clock();
+		const auto wall_end = ClockT::now();
+
+		::printf("pause_idle,threads=%d,wait_ms=%.3f,cpu_ms=%.3f\n", threads_num, get_ms(wall_end - wall_begin), get_cpu_ms(cpu_begin, cpu_end));
+		pool.resume();
+		pool.stop();
+	}
+
+	/**
+	 * @brief	ͻĵ΢Ͷݵʼִеӳ, ÿͶ֮мù߳̽в
+	*/
+	void bench_idle_latency(const char* policy_name, const PoolT::IdlePolicyT& idle_policy, int threads_num, int samples_num, int gap_us) noexcept
+	{
+		PoolT pool;
+		pool.set_multi(true);
+		pool.set_idle_policy(idle_policy);
+		pool.start(threads_num);
+
+		::std::vector<double> samples_us((size_t)samples_num);
+		::std::atomic<bool> done{ false };
+		for (int i = 0; i < samples_num; ++i)
+		{
+			done = false;
+			const auto begin = ClockT::now();
+			pool.post([&samples_us, &done, begin, i]()
+				{
+					samples_us[(size_t)i] = 1000.0 * get_ms(ClockT::now() - begin);
+					done = true;
+				});
+			while (!done)
+				::std::this_thread::yield();
+			::std::this_thread::sleep_for(::std::chrono::microseconds(gap_us));
+		}
+		pool.stop();
+
+		char params[128];
+		::snprintf(params, sizeof(params), "policy=%s,threads=%d,gap_us=%d", policy_name, threads_num, gap_us);
+		print_latency("idle_latency", params, samples_us);
+	}
+
+	/**
+	 * @brief	producers_num ߳ͬʱͶݿ, ͳƴӿʼͶݵȫִ
+	*/
+	void bench_submit_throughput(int threads_num, int producers_num, int tasks_num) noexcept
+	{
+		PoolT pool;
+		pool.set_multi(true);
+		pool.start(threads_num);
+
+		::std::atomic<int> ready{ 0 };
+		::std::atomic<bool> go{ false };
+		::std::vector<::std::thread> producers;
+		for (int i = 0; i < producers_num; ++i)
+		{
+			producers.emplace_back([&pool, &ready, &go, tasks_num, producers_num]()
+				{
+					++ready;
+					while (!go)
+						::std::this_thread::yield();
+					for (int j = tasks_num / producers_num; j > 0; --j)
+						pool.post([]() {});
+				});
+		}
+		while (ready != producers_num)
+			::std::this_thread::yield();
+
+		const auto begin = ClockT::now();
+		go = true;
+		for (::std::thread& producer : producers)
+			producer.join();
+		pool.wait_all_done();
+		const double ms = get_ms(ClockT::now() - begin);
+		pool.stop();
+
+		const int total = tasks_num / producers_num * producers_num;
+		::printf("submit_throughput,threads=%d,producers=%d,tasks=%d,ms=%.3f,mtasks_per_s=%.3f\n",
+			threads_num, producers_num, total, ms, (double)total / ms / 1000.0);
+	}
+
+	/**
+	 * @brief	ͶʱͶݵʼִеӳ
+	*/
+	void bench_submit_latency(int threads_num, int bursts_num, int burst_size) noexcept
+	{
+		PoolT pool;
+		pool.set_multi(true);
+		pool.start(threads_num);
+
+		::std::vector<double> samples_us((size_t)bursts_num * (size_t)burst_size);
+		for (int i = 0; i < bursts_num; ++i)
+		{
+			for (int j = 0; j < burst_size; ++j)
+			{
+				const size_t index = (size_t)i * (size_t)burst_size + (size_t)j;
+				const auto begin = ClockT::now();
+				pool.post([&samples_us, begin, index]() { samples_us[index] = 1000.0 * get_ms(ClockT::now() - begin); });
+			}
+			pool.wait_all_done();
+		}
+		pool.stop();
+
+		char params[128];
+		::snprintf(params, sizeof(params), "threads=%d,burst=%d", threads_num, burst_size);
+		print_latency("submit_latency", params, samples_us);
+	}
+
+	/**
+	 * @brief	ÿͶ width С񲢵ȴȫ future, ͳÿֺʱ
+	*/
+	void bench_fan_out_in(int threads_num, int width, int rounds_num) noexcept
+	{
+		PoolT pool;
+		pool.set_multi(true);
+		pool.start(threads_num);
+
+		::std::vector<double> samples_us((size_t)rounds_num);
+		long long sum = 0;
+		for (int i = 0; i < rounds_num; ++i)
+		{
+			const auto begin = ClockT::now();
+			auto futures = pool.submit_bulk((size_t)width, [](size_t index) { return [index]() { return (long long)index; }; });
+			for (auto& future : futures)
+				sum += future.get();
+			samples_us[(size_t)i] = 1000.0 * get_ms(ClockT::now() - begin);
+		}
+		pool.stop();
+
+		char params[128];
+		::snprintf(params, sizeof(params), "threads=%d,width=%d,checksum=%lld", threads_num, width, sum);
+		print_latency("fan_out_in", params, samples_us);
+	}
+
+	/**
+	 * @brief	ÿͶ burst_size , Ͷ߳ waiters_num ȴ߳ͬʱ wait_all_done,
+	 *			ͳÿִӿʼͶݵеȴ̷߳صĺʱ
+	*/
+	void bench_wait_all_done(int threads_num, int waiters_num, int rounds_num, int burst_size) noexcept
+	{
+		PoolT pool;
+		pool.set_multi(true);
+		pool.start(threads_num);
+
+		::std::atomic<int> round{ 0 };
+		::std::atomic<int> arrived{ 0 };
+		::std::vector<::std::thread> waiters;
+		for (int i = 0; i < waiters_num; ++i)
+		{
+			waiters.emplace_back([&pool, &round, &arrived, rounds_num]()
+				{
+					for (int seen = 0; seen < rounds_num; )
+					{
+						if (round.load() == seen)
+						{
+							::std::this_thread::yield();
+							continue;
+						}
+						++seen;
+						pool.wait_all_done();
+						++arrived;
+					}
+				});
+		}
+
+		::std::vector<double> samples_us((size_t)rounds_num);
+		const auto total_begin = ClockT::now();
+		for (int i = 0; i < rounds_num; ++i)
+		{
+			const auto begin = ClockT::now();
+			arrived = 0;
+			for (int j = 0; j < burst_size; ++j)
+				pool.post([]()
+					{
+						const auto start = ClockT::now();
+						while (ClockT::now() - start < ::std::chrono::microseconds(2));
+					});
+			++round;
+			pool.wait_all_done();
+			while (arrived != waiters_num)
+				::std::this_thread::yield();
+			samples_us[(size_t)i] = 1000.0 * get_ms(ClockT::now() - begin);
+		}
+		const double ms = get_ms(ClockT::now() - total_begin);
+		for (::std::thread& waiter : waiters)
+			waiter.join();
+		pool.stop();
+
+		char params[160];
+		::snprintf(params, sizeof(params), "threads=%d,waiters=%d,burst=%d,total_ms=%.3f", threads_num, waiters_num, burst_size, ms);
+		print_latency("wait_all_done", params, samples_us);
+	}
+
+	void spawn_tree(PoolT& pool, ::std::atomic<long long>& leaves, int depth) noexcept
+	{
+		if (depth == 0)
+		{
+			leaves.fetch_add(1, ::std::memory_order_relaxed);
+			return;
+		}
+		pool.post([&pool, &leaves, depth]() { spawn_tree(pool, leaves, depth - 1); });
+		pool.post([&pool, &leaves, depth]() { spawn_tree(pool, leaves, depth - 1); });
+	}
+
+	/**
+	 * @brief	ڲݹͶ, γΪ depth Ķ, ͳȫ
+	 * @note	local_submit Ϊ false Ҳȡʱ, ȫ빲
+	*/
+	void bench_recursive_spawn(int threads_num, bool stealing, bool local_submit, int depth) noexcept
+	{
+		PoolT pool;
+		pool.set_multi(true);
+		pool.set_stealing(stealing);
+		pool.set_local_submit(local_submit);
+		pool.start(threads_num);
+
+		::std::atomic<long long> leaves{ 0 };
+		const auto begin = ClockT::now();
+		pool.post([&pool, &leaves, depth]() { spawn_tree(pool, leaves, depth); });
+		pool.wait_all_done();
+		const double ms = get_ms(ClockT::now() - begin);
+		pool.stop();
+
+		const long long tasks_num = (2LL << depth) - 1;
+		::printf("recursive_spawn,threads=%d,stealing=%d,local_submit=%d,depth=%d,leaves=%lld,ms=%.3f,mtasks_per_s=%.3f\n",
+			threads_num, (int)stealing, (int)local_submit, depth, leaves.load(), ms, (double)tasks_num / ms / 1000.0);
+	}
+
+	/**
+	 * @brief	ȼֲ [-4, 4] Ͷ, ͨ͡ͳŶӳ
+	*/
+	void bench_priority_mix(int threads_num, int tasks_num, int work_us) noexcept
+	{
+		PoolT pool;
+		pool.set_multi(true);
+		pool.start(threads_num);
+
+		::std::vector<double> samples_us((size_t)tasks_num);
+		::std::vector<int> priorities((size_t)tasks_num);
+		::std::mt19937 random(12345);
+		::std::uniform_int_distribution<int> distribution(-4, 4);
+		for (int i = 0; i < tasks_num; ++i)
+		{
+			const int priority = distribution(random);
+			priorities[(size_t)i] = priority;
+			const auto begin = ClockT::now();
+			pool.post(priority, [&samples_us, begin, i, work_us]()
+				{
+					const auto start = ClockT::now();
+					samples_us[(size_t)i] = 1000.0 * get_ms(start - begin);
+					while (ClockT::now() - start < ::std::chrono::microseconds(work_us));
+				});
+		}
+		pool.wait_all_done();
+		pool.stop();
+
+		const char* names[3] = { "low", "normal", "high" };
+		::std::vector<double> classes[3];
+		for (int i = 0; i < tasks_num; ++i)
+			classes[priorities[(size_t)i] < 0 ? 0 : priorities[(size_t)i] == 0 ? 1 : 2].push_back(samples_us[(size_t)i]);
+		for (int i = 0; i < 3; ++i)
+		{
+			char params[128];
+			::snprintf(params, sizeof(params), "threads=%d,class=%s,work_us=%d", threads_num, names[i], work_us);
+			print_latency("priority_mix", params, classes[i]);
+		}
+	}
+
+	/**
+	 * @brief	ŶΪ capacity ʱ producers_num ̰߳ policy Ͷݶ, ͳͱܾ̭
+	*/
+	void bench_bounded_submit(const char* policy_name, PoolT::OverflowPolicyT policy, int threads_num, int producers_num, int tasks_num, int capacity) noexcept
+	{
+		PoolT pool;
+		pool.set_multi(true);
+		pool.set_bound(PoolT::BoundT{ (PoolT::TaskNumT)capacity, policy });
+		pool.start(threads_num);
+
+		::std::atomic<int> ready{ 0 };
+		::std::atomic<bool> go{ false };
+		::std::vector<::std::thread> producers;
+		for (int i = 0; i < producers_num; ++i)
+		{
+			producers.emplace_back([&pool, &ready, &go, tasks_num, producers_num]()
+				{
+					++ready;
+					while (!go)
+						::std::this_thread::yield();
+					for (int j = tasks_num / producers_num; j > 0; --j)
+					{
+						pool.post([]()
+							{
+								const auto start = ClockT::now();
+								while (ClockT::now() - start < ::std::chrono::microseconds(1));
+							});
+					}
+				});
+		}
+		while (ready != producers_num)
+			::std::this_thread::yield();
+
+		const auto begin = ClockT::now();
+		go = true;
+		for (::std::thread& producer : producers)
+			producer.join();
+		pool.wait_all_done();
+		const double ms = get_ms(ClockT::now() - begin);
+		const PoolT::OverflowStatsT stats = pool.get_overflow_stats();
+		pool.stop();
+
+		const int total = tasks_num / producers_num * producers_num;
+		::printf("bounded_submit,policy=%s,threads=%d,producers=%d,capacity=%d,tasks=%d,ms=%.3f,mtasks_per_s=%.3f,rejected=%llu,evicted=%llu\n",
+			policy_name, threads_num, producers_num, capacity, total, ms, (double)total / ms / 1000.0,
+			(unsigned long long)stats.m_rejected_num, (unsigned long long)stats.m_evicted_num);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* name = argc > 1 ? argv[1] : "all";
+	const bool all = ::strcmp(name, "all") == 0;
+	const unsigned int hardware_num = ::std::thread::hardware_concurrency();
+	const int max_threads_num = argc > 2 ? ::atoi(argv[2]) : (hardware_num ? (int)hardware_num : 4);
+	const ::std::vector<int> sweep = get_threads_sweep(max_threads_num > 0 ? max_threads_num : 1);
+
+	if (all || ::strcmp(name, "pause_idle") == 0)
+		bench_pause_idle(4, 200);
+	if (all || ::strcmp(name, "idle_latency") == 0)
+	{
+		bench_idle_latency("park", PoolT::IdlePolicyT{ 0, 0 }, 4, 2000, 50);
+		bench_idle_latency("yield", PoolT::IdlePolicyT{ 0, 64 }, 4, 2000, 50);
+		bench_idle_latency("spin", PoolT::IdlePolicyT{ 1u << 14, 0 }, 4, 2000, 50);
+		bench_idle_latency("spin_yield", PoolT::IdlePolicyT{ 1u << 12, 64 }, 4, 2000, 50);
+	}
+	if (all || ::strcmp(name, "submit_throughput") == 0)
+		for (int threads_num : sweep)
+			for (int producers_num : sweep)
+				bench_submit_throughput(threads_num, producers_num, 1 << 18);
+	if (all || ::strcmp(name, "submit_latency") == 0)
+		for (int threads_num : sweep)
+			bench_submit_latency(threads_num, 200, 64);
+	if (all || ::strcmp(name, "fan_out_in") == 0)
+		for (int threads_num : sweep)
+			bench_fan_out_in(threads_num, 256, 200);
+	if (all || ::strcmp(name, "wait_all_done") == 0)
+		for (int waiters_num : { 0, 1, 4, 16, 64 })
+			bench_wait_all_done(max_threads_num, waiters_num, 2000, 256);
+	if (all || ::strcmp(name, "recursive_spawn") == 0)
+		for (int threads_num : sweep)
+		{
+			bench_recursive_spawn(threads_num, false, false, 16);
+			bench_recursive_spawn(threads_num, false, true, 16);
+			bench_recursive_spawn(threads_num, true, true, 16);
+		}
+	if (all || ::strcmp(name, "priority_mix") == 0)
+		for (int threads_num : sweep)
+			bench_priority_mix(threads_num, 20000, 2);
+	if (all || ::strcmp(name, "bounded_submit") == 0)
+		for (int capacity : { 0, 64, 1024 })
+		{
+			bench_bounded_submit("block", PoolT::OverflowPolicyT::block, max_threads_num, 4, 1 << 16, capacity);
+			bench_bounded_submit("reject", PoolT::OverflowPolicyT::reject, max_threads_num, 4, 1 << 16, capacity);
+			bench_bounded_submit("drop_oldest", PoolT::OverflowPolicyT::drop_oldest, max_threads_num, 4, 1 << 16, capacity);
+		}
+	return 0;
+}
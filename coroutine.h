@@ -0,0 +1,190 @@
+/**
+ * @file	coroutine.h
+ * @brief	HiCxx Эģ
+ * @author	
+*/
+
+#pragma once
+
+#include "hicxx_defines.h"
+
+#ifdef _HICXX_COROUTINE
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.h"
+#include "parallel.h"
+
+namespace HiCxx
+{
+	template<class _Ret = void> class task;
+
+	/**
+	 * @brief	task Э̵Ĺ
+	 * @note	Э̴,  co_await ʱſʼִ; ִϺֱתƵȴ, ̳߳
+	*/
+	class coroutine_promise_base
+	{
+	public:
+		struct FinalAwaiterT
+		{
+			bool await_ready() const noexcept;
+			template<class _TPromise>
+			::std::coroutine_handle<> await_suspend(::std::coroutine_handle<_TPromise> handle) noexcept;
+			void await_resume() const noexcept;
+		};
+
+		::std::suspend_always initial_suspend() const noexcept;
+		FinalAwaiterT final_suspend() const noexcept;
+		void unhandled_exception() noexcept;
+
+		::std::coroutine_handle<>	m_continuation;
+		::std::exception_ptr		m_exception;
+	};
+
+	template<class _Ret> class coroutine_promise : public coroutine_promise_base
+	{
+	public:
+		task<_Ret> get_return_object() noexcept;
+		template<class _TValue>
+		void return_value(_TValue&& value);
+		_Ret get();
+
+		::std::optional<_Ret>		m_value;
+	};
+	template<> class coroutine_promise<void> : public coroutine_promise_base
+	{
+	public:
+		task<void> get_return_object() noexcept;
+		void return_void() const noexcept;
+		void get();
+	};
+
+	/**
+	 * @brief	ɵȴЭ
+	 * @note	co_await õֵ׳쳣, ֻȡһ; Э co_await pool.schedule() л߳
+	*/
+	template<class _Ret> class task
+	{
+	public:
+		using promise_type	= coroutine_promise<_Ret>;
+		using HandleT		= ::std::coroutine_handle<promise_type>;
+
+		struct AwaiterT
+		{
+			HandleT			m_handle;
+
+			bool await_ready() const noexcept;
+			::std::coroutine_handle<> await_suspend(::std::coroutine_handle<> continuation) noexcept;
+			_Ret await_resume();
+		};
+		struct ReadyAwaiterT : AwaiterT
+		{
+			void await_resume() const noexcept;
+		};
+
+		task() noexcept = default;
+		explicit task(HandleT handle) noexcept;
+		task(task&& other) noexcept;
+		task(const task& other) = delete;
+		~task() noexcept;
+
+		task& operator=(task&& other) noexcept;
+		task& operator=(const task& other) = delete;
+
+		bool valid() const noexcept;
+		bool is_ready() const noexcept;
+		_Ret get();
+		AwaiterT operator co_await() noexcept;
+		ReadyAwaiterT when_ready() noexcept;
+
+	protected:
+		HandleT m_handle;
+	};
+
+	/**
+	 * @brief	ִҽٵЭ, ڲ
+	*/
+	class coroutine_detached
+	{
+	public:
+		struct promise_type
+		{
+			coroutine_detached get_return_object() const noexcept;
+			::std::suspend_never initial_suspend() const noexcept;
+			::std::suspend_never final_suspend() const noexcept;
+			void return_void() const noexcept;
+			void unhandled_exception() const noexcept;
+		};
+	};
+
+	/**
+	 * @brief	when_all ɼ
+	 * @note	ֵΪһ, һɹȫ۳, ۳һָȴ
+	*/
+	class coroutine_counter
+	{
+	public:
+		using CountT		= ::std::atomic<size_t>;
+
+		bool start(::std::coroutine_handle<> continuation) noexcept;
+		void done() noexcept;
+
+		CountT						m_pending{ 1 };
+		::std::coroutine_handle<>	m_continuation;
+	};
+
+	/**
+	 * @brief	when_any Ĺ״̬
+	 * @note	ִеͬ, ȴ߻ָδɵֱִ;
+	 *			бΪʱ, ޷ֵ when_any  npos, зֵ׳ ::std::invalid_argument
+	*/
+	template<class _Ret> class coroutine_when_any_state
+	{
+	public:
+		using TaskVectorT	= ::std::vector<task<_Ret>>;
+		using StatePtrT		= ::std::shared_ptr<coroutine_when_any_state>;
+		static constexpr size_t npos = (size_t)-1;
+
+		struct AwaiterT
+		{
+			const StatePtrT&	m_state;
+
+			bool await_ready() const noexcept;
+			bool await_suspend(::std::coroutine_handle<> continuation) noexcept;
+			size_t await_resume() const noexcept;
+		};
+
+		void done(size_t index) noexcept;
+
+		TaskVectorT					m_tasks;
+		::std::atomic<size_t>		m_index{ npos };
+		::std::atomic<int>			m_tickets{ 0 };
+		::std::coroutine_handle<>	m_continuation;
+	};
+
+	template<class _Ret>
+	coroutine_detached coroutine_when_all_runner(task<_Ret>& target, coroutine_counter& counter);
+	template<class _Ret>
+	coroutine_detached coroutine_when_any_runner(::std::shared_ptr<coroutine_when_any_state<_Ret>> state, size_t index);
+	template<class _Ret>
+	coroutine_detached coroutine_sync_runner(task<_Ret>& target, parallel_state& state);
+
+	template<class _Ret>
+	auto when_all(::std::vector<task<_Ret>> tasks)
+		-> task<::std::conditional_t<::std::is_void<_Ret>::value, void, ::std::vector<_Ret>>>;
+	template<class _Ret>
+	auto when_any(::std::vector<task<_Ret>> tasks)
+		-> task<::std::conditional_t<::std::is_void<_Ret>::value, size_t, ::std::pair<size_t, _Ret>>>;
+	template<class _Ret>
+	_Ret sync_wait(thread_pool_public& pool, task<_Ret> target);
+}
+
+#endif
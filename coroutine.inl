@@ -0,0 +1,324 @@
+/**
+ * @file	coroutine.inl
+ * @brief	HiCxx Эģ
+ * @author	
+*/
+
+#include "coroutine.h"
+
+#ifdef _HICXX_COROUTINE
+
+namespace HiCxx
+{
+	inline bool coroutine_promise_base::FinalAwaiterT::await_ready() const noexcept
+	{
+		return false;
+	}
+
+	template<class _TPromise>
+	inline ::std::coroutine_handle<> coroutine_promise_base::FinalAwaiterT::await_suspend(::std::coroutine_handle<_TPromise> handle) noexcept
+	{
+		::std::coroutine_handle<> continuation = handle.promise().m_continuation;
+		return continuation ? continuation : ::std::noop_coroutine();
+	}
+
+	inline void coroutine_promise_base::FinalAwaiterT::await_resume() const noexcept
+	{
+	}
+
+	inline ::std::suspend_always coroutine_promise_base::initial_suspend() const noexcept
+	{
+		return {};
+	}
+
+	inline coroutine_promise_base::FinalAwaiterT coroutine_promise_base::final_suspend() const noexcept
+	{
+		return {};
+	}
+
+	inline void coroutine_promise_base::unhandled_exception() noexcept
+	{
+		this->m_exception = ::std::current_exception();
+	}
+
+	template<class _Ret>
+	inline task<_Ret> coroutine_promise<_Ret>::get_return_object() noexcept
+	{
+		return task<_Ret>(task<_Ret>::HandleT::from_promise(*this));
+	}
+
+	template<class _Ret>
+	template<class _TValue>
+	inline void coroutine_promise<_Ret>::return_value(_TValue&& value)
+	{
+		this->m_value.emplace(::std::forward<_TValue>(value));
+	}
+
+	template<class _Ret>
+	inline _Ret coroutine_promise<_Ret>::get()
+	{
+		if (this->m_exception)
+			::std::rethrow_exception(this->m_exception);
+		return ::std::move(*this->m_value);
+	}
+
+	inline task<void> coroutine_promise<void>::get_return_object() noexcept
+	{
+		return task<void>(task<void>::HandleT::from_promise(*this));
+	}
+
+	inline void coroutine_promise<void>::return_void() const noexcept
+	{
+	}
+
+	inline void coroutine_promise<void>::get()
+	{
+		if (this->m_exception)
+			::std::rethrow_exception(this->m_exception);
+	}
+
+	template<class _Ret>
+	inline bool task<_Ret>::AwaiterT::await_ready() const noexcept
+	{
+		return !this->m_handle || this->m_handle.done();
+	}
+
+	template<class _Ret>
+	inline ::std::coroutine_handle<> task<_Ret>::AwaiterT::await_suspend(::std::coroutine_handle<> continuation) noexcept
+	{
+		this->m_handle.promise().m_continuation = continuation;
+		return this->m_handle;
+	}
+
+	template<class _Ret>
+	inline _Ret task<_Ret>::AwaiterT::await_resume()
+	{
+		return this->m_handle.promise().get();
+	}
+
+	template<class _Ret>
+	inline void task<_Ret>::ReadyAwaiterT::await_resume() const noexcept
+	{
+	}
+
+	template<class _Ret>
+	inline task<_Ret>::task(HandleT handle) noexcept
+		: m_handle(handle)
+	{
+	}
+
+	template<class _Ret>
+	inline task<_Ret>::task(task&& other) noexcept
+		: m_handle(::std::exchange(other.m_handle, nullptr))
+	{
+	}
+
+	template<class _Ret>
+	inline task<_Ret>::~task() noexcept
+	{
+		if (this->m_handle)
+			this->m_handle.destroy();
+	}
+
+	template<class _Ret>
+	inline task<_Ret>& task<_Ret>::operator=(task&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (this->m_handle)
+				this->m_handle.destroy();
+			this->m_handle = ::std::exchange(other.m_handle, nullptr);
+		}
+		return *this;
+	}
+
+	template<class _Ret>
+	inline bool task<_Ret>::valid() const noexcept
+	{
+		return (bool)this->m_handle;
+	}
+
+	template<class _Ret>
+	inline bool task<_Ret>::is_ready() const noexcept
+	{
+		return this->m_handle && this->m_handle.done();
+	}
+
+	template<class _Ret>
+	inline _Ret task<_Ret>::get()
+	{
+		return this->m_handle.promise().get();
+	}
+
+	template<class _Ret>
+	inline typename task<_Ret>::AwaiterT task<_Ret>::operator co_await() noexcept
+	{
+		return AwaiterT{ this->m_handle };
+	}
+
+	template<class _Ret>
+	inline typename task<_Ret>::ReadyAwaiterT task<_Ret>::when_ready() noexcept
+	{
+		return ReadyAwaiterT{ { this->m_handle } };
+	}
+
+	inline coroutine_detached coroutine_detached::promise_type::get_return_object() const noexcept
+	{
+		return {};
+	}
+
+	inline ::std::suspend_never coroutine_detached::promise_type::initial_suspend() const noexcept
+	{
+		return {};
+	}
+
+	inline ::std::suspend_never coroutine_detached::promise_type::final_suspend() const noexcept
+	{
+		return {};
+	}
+
+	inline void coroutine_detached::promise_type::return_void() const noexcept
+	{
+	}
+
+	inline void coroutine_detached::promise_type::unhandled_exception() const noexcept
+	{
+		::std::terminate();
+	}
+
+	inline bool coroutine_counter::start(::std::coroutine_handle<> continuation) noexcept
+	{
+		this->m_continuation = continuation;
+		return this->m_pending.fetch_sub(1, ::std::memory_order_acq_rel) != 1;
+	}
+
+	inline void coroutine_counter::done() noexcept
+	{
+		if (this->m_pending.fetch_sub(1, ::std::memory_order_acq_rel) == 1)
+			this->m_continuation.resume();
+	}
+
+	template<class _Ret>
+	inline bool coroutine_when_any_state<_Ret>::AwaiterT::await_ready() const noexcept
+	{
+		return this->m_state->m_tasks.empty();
+	}
+
+	template<class _Ret>
+	inline bool coroutine_when_any_state<_Ret>::AwaiterT::await_suspend(::std::coroutine_handle<> continuation) noexcept
+	{
+		coroutine_when_any_state& state = *this->m_state;
+		state.m_continuation = continuation;
+		for (size_t i = 0; i < state.m_tasks.size(); ++i)
+			coroutine_when_any_runner<_Ret>(this->m_state, i);
+		return state.m_tickets.fetch_add(1, ::std::memory_order_acq_rel) == 0;
+	}
+
+	template<class _Ret>
+	inline size_t coroutine_when_any_state<_Ret>::AwaiterT::await_resume() const noexcept
+	{
+		return this->m_state->m_index;
+	}
+
+	template<class _Ret>
+	inline void coroutine_when_any_state<_Ret>::done(size_t index) noexcept
+	{
+		size_t expected = npos;
+		if (!this->m_index.compare_exchange_strong(expected, index, ::std::memory_order_acq_rel))
+			return;
+		if (this->m_tickets.fetch_add(1, ::std::memory_order_acq_rel) == 1)
+			this->m_continuation.resume();
+	}
+
+	template<class _Ret>
+	inline coroutine_detached coroutine_when_all_runner(task<_Ret>& target, coroutine_counter& counter)
+	{
+		co_await target.when_ready();
+		counter.done();
+	}
+
+	template<class _Ret>
+	inline coroutine_detached coroutine_when_any_runner(::std::shared_ptr<coroutine_when_any_state<_Ret>> state, size_t index)
+	{
+		co_await state->m_tasks[index].when_ready();
+		state->done(index);
+	}
+
+	template<class _Ret>
+	inline coroutine_detached coroutine_sync_runner(task<_Ret>& target, parallel_state& state)
+	{
+		co_await target.when_ready();
+		state.done();
+	}
+
+	template<class _Ret>
+	inline auto when_all(::std::vector<task<_Ret>> tasks)
+		-> task<::std::conditional_t<::std::is_void<_Ret>::value, void, ::std::vector<_Ret>>>
+	{
+		struct AwaiterT
+		{
+			::std::vector<task<_Ret>>&	m_tasks;
+			coroutine_counter			m_counter;
+
+			bool await_ready() const noexcept { return this->m_tasks.empty(); }
+			bool await_suspend(::std::coroutine_handle<> continuation) noexcept
+			{
+				this->m_counter.m_pending += this->m_tasks.size();
+				for (task<_Ret>& target : this->m_tasks)
+					coroutine_when_all_runner(target, this->m_counter);
+				return this->m_counter.start(continuation);
+			}
+			void await_resume() const noexcept {}
+		};
+		co_await AwaiterT{ tasks, {} };
+
+		if constexpr (::std::is_void<_Ret>::value)
+		{
+			for (task<_Ret>& target : tasks)
+				target.get();
+		}
+		else
+		{
+			::std::vector<_Ret> results;
+			results.reserve(tasks.size());
+			for (task<_Ret>& target : tasks)
+				results.push_back(target.get());
+			co_return results;
+		}
+	}
+
+	template<class _Ret>
+	inline auto when_any(::std::vector<task<_Ret>> tasks)
+		-> task<::std::conditional_t<::std::is_void<_Ret>::value, size_t, ::std::pair<size_t, _Ret>>>
+	{
+		using StateT = coroutine_when_any_state<_Ret>;
+		auto state = ::std::make_shared<StateT>();
+		state->m_tasks = ::std::move(tasks);
+		const size_t index = co_await typename StateT::AwaiterT{ state };
+
+		if constexpr (::std::is_void<_Ret>::value)
+		{
+			if (index != StateT::npos)
+				state->m_tasks[index].get();
+			co_return index;
+		}
+		else
+		{
+			if (index == StateT::npos)
+				throw ::std::invalid_argument("when_any requires at least one task");
+			co_return ::std::pair<size_t, _Ret>(index, state->m_tasks[index].get());
+		}
+	}
+
+	template<class _Ret>
+	inline _Ret sync_wait(thread_pool_public& pool, task<_Ret> target)
+	{
+		parallel_state state;
+		state.add();
+		coroutine_sync_runner(target, state);
+		state.wait(pool);
+		return target.get();
+	}
+}
+
+#endif
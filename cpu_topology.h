@@ -0,0 +1,57 @@
+/**
+ * @file	cpu_topology.h
+ * @brief	HiCxx  CPU ģ
+ * @author	
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HiCxx
+{
+	/**
+	 * @brief	CPU  NUMA ڵ
+	 * @note	Linux ´ /sys/devices/system/node  /sys/devices/system/cpu ȡ, ޳׺֮ CPU;
+	 *			ƽ̨ȡʧʱ˻Ϊһȫ߼ CPU Ľڵ, ҰΪղ
+	*/
+	class cpu_topology
+	{
+	public:
+		using CpuT			= ::int32_t;
+		using CpuVectorT	= ::std::vector<CpuT>;
+		static constexpr CpuT npos = -1;
+
+		struct NodeT
+		{
+			::int32_t		m_id = 0;
+			CpuVectorT		m_cpus;
+		};
+		using NodeVectorT	= ::std::vector<NodeT>;
+
+		cpu_topology() noexcept = default;
+
+		bool load() noexcept;
+		bool empty() const noexcept;
+		size_t get_nodes_num() const noexcept;
+		size_t get_cpus_num() const noexcept;
+		const NodeVectorT& get_nodes() const noexcept;
+		CpuT get_cpu(size_t index, bool scatter) const noexcept;
+		size_t get_node_index(CpuT cpu) const noexcept;
+
+		static CpuT get_current_cpu() noexcept;
+		static bool pin_current_thread(CpuT cpu) noexcept;
+		static bool parse_cpu_list(const ::std::string& text, CpuVectorT& cpus) noexcept;
+
+	protected:
+		static bool read_file(const char* path, ::std::string& text) noexcept;
+		static bool is_allowed(CpuT cpu) noexcept;
+		bool load_nodes() noexcept;
+		void load_flat() noexcept;
+
+		NodeVectorT		m_nodes;
+		CpuVectorT		m_cpus;
+	};
+}
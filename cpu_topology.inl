@@ -0,0 +1,197 @@
+/**
+ * @file	cpu_topology.inl
+ * @brief	HiCxx  CPU ģ
+ * @author	
+*/
+
+#include "cpu_topology.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace HiCxx
+{
+	inline bool cpu_topology::load() noexcept
+	{
+		this->m_nodes.clear();
+		this->m_cpus.clear();
+		if (!this->load_nodes())
+			this->load_flat();
+
+		for (const NodeT& node : this->m_nodes)
+			this->m_cpus.insert(this->m_cpus.end(), node.m_cpus.begin(), node.m_cpus.end());
+		return !this->m_cpus.empty();
+	}
+
+	inline bool cpu_topology::empty() const noexcept
+	{
+		return this->m_cpus.empty();
+	}
+
+	inline size_t cpu_topology::get_nodes_num() const noexcept
+	{
+		return this->m_nodes.size();
+	}
+
+	inline size_t cpu_topology::get_cpus_num() const noexcept
+	{
+		return this->m_cpus.size();
+	}
+
+	inline const cpu_topology::NodeVectorT& cpu_topology::get_nodes() const noexcept
+	{
+		return this->m_nodes;
+	}
+
+	inline cpu_topology::CpuT cpu_topology::get_cpu(size_t index, bool scatter) const noexcept
+	{
+		if (this->m_cpus.empty())
+			return npos;
+		if (!scatter)
+			return this->m_cpus[index % this->m_cpus.size()];
+
+		const NodeT& node = this->m_nodes[index % this->m_nodes.size()];
+		return node.m_cpus[(index / this->m_nodes.size()) % node.m_cpus.size()];
+	}
+
+	inline size_t cpu_topology::get_node_index(CpuT cpu) const noexcept
+	{
+		for (size_t i = 0; i < this->m_nodes.size(); ++i)
+			for (CpuT node_cpu : this->m_nodes[i].m_cpus)
+				if (node_cpu == cpu)
+					return i;
+		return 0;
+	}
+
+	inline cpu_topology::CpuT cpu_topology::get_current_cpu() noexcept
+	{
+#ifdef __linux__
+		return (CpuT)::sched_getcpu();
+#else
+		return npos;
+#endif
+	}
+
+	inline bool cpu_topology::pin_current_thread(CpuT cpu) noexcept
+	{
+#ifdef __linux__
+		if (cpu < 0 || cpu >= CPU_SETSIZE)
+			return false;
+
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(cpu, &set);
+		return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+		(void)cpu;
+		return false;
+#endif
+	}
+
+	inline bool cpu_topology::parse_cpu_list(const ::std::string& text, CpuVectorT& cpus) noexcept
+	{
+		const char* begin = text.c_str();
+		while (*begin)
+		{
+			char* end = nullptr;
+			const long first = ::strtol(begin, &end, 10);
+			if (end == begin || first < 0)
+				return false;
+
+			long last = first;
+			if (*end == '-')
+			{
+				begin = end + 1;
+				last = ::strtol(begin, &end, 10);
+				if (end == begin || last < first)
+					return false;
+			}
+			for (long cpu = first; cpu <= last; ++cpu)
+				cpus.push_back((CpuT)cpu);
+
+			while (*end == ',' || *end == '\n' || *end == ' ')
+				++end;
+			begin = end;
+		}
+		return true;
+	}
+
+	inline bool cpu_topology::read_file(const char* path, ::std::string& text) noexcept
+	{
+		::FILE* file = ::fopen(path, "r");
+		if (!file)
+			return false;
+
+		char buffer[1024];
+		text.clear();
+		for (size_t size; (size = ::fread(buffer, 1, sizeof(buffer), file)) != 0; )
+			text.append(buffer, size);
+		::fclose(file);
+		return !text.empty();
+	}
+
+	inline bool cpu_topology::is_allowed(CpuT cpu) noexcept
+	{
+#ifdef __linux__
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if (::sched_getaffinity(0, sizeof(set), &set) != 0 || cpu >= CPU_SETSIZE)
+			return true;
+		return CPU_ISSET(cpu, &set);
+#else
+		(void)cpu;
+		return true;
+#endif
+	}
+
+	inline bool cpu_topology::load_nodes() noexcept
+	{
+		::std::string text;
+		CpuVectorT node_ids;
+		if (!read_file("/sys/devices/system/node/online", text) || !parse_cpu_list(text, node_ids))
+			return false;
+
+		for (CpuT node_id : node_ids)
+		{
+			char path[128];
+			::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", (int)node_id);
+			NodeT node{ node_id, {} };
+			CpuVectorT cpus;
+			if (!read_file(path, text) || !parse_cpu_list(text, cpus))
+				continue;
+
+			for (CpuT cpu : cpus)
+				if (is_allowed(cpu))
+					node.m_cpus.push_back(cpu);
+			if (!node.m_cpus.empty())
+				this->m_nodes.push_back(::std::move(node));
+		}
+		return !this->m_nodes.empty();
+	}
+
+	inline void cpu_topology::load_flat() noexcept
+	{
+		::std::string text;
+		CpuVectorT cpus;
+		if (!read_file("/sys/devices/system/cpu/online", text) || !parse_cpu_list(text, cpus))
+		{
+			cpus.clear();
+			const unsigned int num = ::std::thread::hardware_concurrency();
+			for (unsigned int i = 0; i < (num ? num : 1); ++i)
+				cpus.push_back((CpuT)i);
+		}
+
+		NodeT node{ 0, {} };
+		for (CpuT cpu : cpus)
+			if (is_allowed(cpu))
+				node.m_cpus.push_back(cpu);
+		if (!node.m_cpus.empty())
+			this->m_nodes.push_back(::std::move(node));
+	}
+}
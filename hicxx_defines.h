@@ -12,4 +12,23 @@
 #define _HICXX_ASSERT(expr,msg) _ASSERT_EXPR(expr,msg)
 #else
 #define _HICXX_ASSERT(expr,msg) _ASSERT_EXPR(expr,msg)
-#endif
\ No newline at end of file
+#endif
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define _HICXX_COROUTINE
+#endif
+
+#if defined(_HICXX_METRICS) || defined(_HICXX_TRACE)
+#define _HICXX_TASK_TIMESTAMP
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define _HICXX_PAUSE() _mm_pause()
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define _HICXX_PAUSE() __builtin_ia32_pause()
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+#define _HICXX_PAUSE() __asm__ __volatile__("yield")
+#else
+#define _HICXX_PAUSE() ((void)0)
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file	histogram.h
+ * @brief	HiCxx ֱͼģ
+ * @author	
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace HiCxx
+{
+	/**
+	 * @brief	ͰĲֱͼ
+	 * @note	 HDR ֱͼ, С sub_buckets_num ֵռһͰ, ֵλֶ, ÿپΪ sub_buckets_num Ͱ,
+	 *			 1 / sub_buckets_num; ¼ֻ relaxed ԭӼ, ȡʱΪ, ;
+	 *			ֻһд߳ʱ record ɴ exclusive,  relaxed дԭӼ
+	*/
+	class histogram
+	{
+	public:
+		using ValueT		= ::uint64_t;
+		using CountT		= ::uint64_t;
+		using AtomicValueT	= ::std::atomic<ValueT>;
+		using AtomicCountT	= ::std::atomic<CountT>;
+		static constexpr size_t sub_buckets_bits	= 3;
+		static constexpr size_t sub_buckets_num		= (size_t)1 << sub_buckets_bits;
+		static constexpr size_t buckets_num			= (64 - sub_buckets_bits + 1) * sub_buckets_num;
+
+		struct SnapshotT
+		{
+			CountT			m_counts[buckets_num] = {};
+			CountT			m_count = 0;
+			ValueT			m_sum = 0;
+			ValueT			m_max = 0;
+
+			void merge(const SnapshotT& snapshot) noexcept;
+			ValueT get_percentile(double percent) const noexcept;
+			double get_mean() const noexcept;
+		};
+
+		histogram() noexcept = default;
+		histogram(const histogram& other) = delete;
+		histogram& operator=(const histogram& other) = delete;
+
+		void record(ValueT value, bool exclusive = false) noexcept;
+		void snapshot(SnapshotT& snapshot) const noexcept;
+		void merge(const histogram& other) noexcept;
+		void clear() noexcept;
+
+		static size_t get_index(ValueT value) noexcept;
+		static ValueT get_lower_bound(size_t index) noexcept;
+		static ValueT get_upper_bound(size_t index) noexcept;
+
+	protected:
+		AtomicCountT	m_counts[buckets_num] = {};
+		AtomicCountT	m_count{ 0 };
+		AtomicValueT	m_sum{ 0 };
+		AtomicValueT	m_max{ 0 };
+	};
+}
@@ -0,0 +1,134 @@
+/**
+ * @file	histogram.inl
+ * @brief	HiCxx ֱͼģ
+ * @author	
+*/
+
+#include "histogram.h"
+
+namespace HiCxx
+{
+	inline void histogram::SnapshotT::merge(const SnapshotT& snapshot) noexcept
+	{
+		for (size_t i = 0; i < buckets_num; ++i)
+			this->m_counts[i] += snapshot.m_counts[i];
+		this->m_count += snapshot.m_count;
+		this->m_sum += snapshot.m_sum;
+		if (snapshot.m_max > this->m_max)
+			this->m_max = snapshot.m_max;
+	}
+
+	inline histogram::ValueT histogram::SnapshotT::get_percentile(double percent) const noexcept
+	{
+		if (this->m_count == 0)
+			return 0;
+
+		const CountT rank = (CountT)(percent / 100.0 * (double)(this->m_count - 1)) + 1;
+		CountT count = 0;
+		for (size_t i = 0; i < buckets_num; ++i)
+		{
+			count += this->m_counts[i];
+			if (count >= rank)
+			{
+				const ValueT upper = get_upper_bound(i);
+				return upper < this->m_max ? upper : this->m_max;
+			}
+		}
+		return this->m_max;
+	}
+
+	inline double histogram::SnapshotT::get_mean() const noexcept
+	{
+		return this->m_count ? (double)this->m_sum / (double)this->m_count : 0.0;
+	}
+
+	inline void histogram::record(ValueT value, bool exclusive) noexcept
+	{
+		if (exclusive)
+		{
+			AtomicCountT& count = this->m_counts[get_index(value)];
+			count.store(count.load(::std::memory_order_relaxed) + 1, ::std::memory_order_relaxed);
+			this->m_count.store(this->m_count.load(::std::memory_order_relaxed) + 1, ::std::memory_order_relaxed);
+			this->m_sum.store(this->m_sum.load(::std::memory_order_relaxed) + value, ::std::memory_order_relaxed);
+			if (value > this->m_max.load(::std::memory_order_relaxed))
+				this->m_max.store(value, ::std::memory_order_relaxed);
+			return;
+		}
+
+		this->m_counts[get_index(value)].fetch_add(1, ::std::memory_order_relaxed);
+		this->m_count.fetch_add(1, ::std::memory_order_relaxed);
+		this->m_sum.fetch_add(value, ::std::memory_order_relaxed);
+		ValueT max = this->m_max.load(::std::memory_order_relaxed);
+		while (value > max && !this->m_max.compare_exchange_weak(max, value, ::std::memory_order_relaxed));
+	}
+
+	inline void histogram::snapshot(SnapshotT& snapshot) const noexcept
+	{
+		SnapshotT current;
+		for (size_t i = 0; i < buckets_num; ++i)
+			current.m_counts[i] = this->m_counts[i].load(::std::memory_order_relaxed);
+		current.m_count = this->m_count.load(::std::memory_order_relaxed);
+		current.m_sum = this->m_sum.load(::std::memory_order_relaxed);
+		current.m_max = this->m_max.load(::std::memory_order_relaxed);
+		snapshot.merge(current);
+	}
+
+	inline void histogram::merge(const histogram& other) noexcept
+	{
+		for (size_t i = 0; i < buckets_num; ++i)
+		{
+			const CountT count = other.m_counts[i].load(::std::memory_order_relaxed);
+			if (count)
+				this->m_counts[i].fetch_add(count, ::std::memory_order_relaxed);
+		}
+		this->m_count.fetch_add(other.m_count.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+		this->m_sum.fetch_add(other.m_sum.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+		const ValueT value = other.m_max.load(::std::memory_order_relaxed);
+		ValueT max = this->m_max.load(::std::memory_order_relaxed);
+		while (value > max && !this->m_max.compare_exchange_weak(max, value, ::std::memory_order_relaxed));
+	}
+
+	inline void histogram::clear() noexcept
+	{
+		for (AtomicCountT& count : this->m_counts)
+			count.store(0, ::std::memory_order_relaxed);
+		this->m_count.store(0, ::std::memory_order_relaxed);
+		this->m_sum.store(0, ::std::memory_order_relaxed);
+		this->m_max.store(0, ::std::memory_order_relaxed);
+	}
+
+	inline size_t histogram::get_index(ValueT value) noexcept
+	{
+		if (value < sub_buckets_num)
+			return (size_t)value;
+
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long magnitude;
+		_BitScanReverse64(&magnitude, value);
+#elif defined(__GNUC__)
+		const size_t magnitude = (size_t)(63 - __builtin_clzll(value));
+#else
+		size_t magnitude = 0;
+		for (ValueT bits = value; bits >>= 1; )
+			++magnitude;
+#endif
+		const size_t shift = (size_t)magnitude - sub_buckets_bits;
+		return (shift + 1) * sub_buckets_num + (size_t)((value >> shift) & (sub_buckets_num - 1));
+	}
+
+	inline histogram::ValueT histogram::get_lower_bound(size_t index) noexcept
+	{
+		if (index < sub_buckets_num)
+			return (ValueT)index;
+
+		const size_t shift = index / sub_buckets_num - 1;
+		return (ValueT)(sub_buckets_num + index % sub_buckets_num) << shift;
+	}
+
+	inline histogram::ValueT histogram::get_upper_bound(size_t index) noexcept
+	{
+		if (index + 1 >= buckets_num)
+			return ~(ValueT)0;
+		return get_lower_bound(index + 1) - 1;
+	}
+}
@@ -0,0 +1,95 @@
+/**
+ * @file	parallel.h
+ * @brief	HiCxx ݲģ
+ * @author	
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace HiCxx
+{
+	/**
+	 * @brief	βеõ״̬
+	 * @note	ֻͳƱε, ̳߳е޹;
+	 *			̳߳ضתȴ߳,  wait ڵ߳ϲ
+	*/
+	class parallel_state
+	{
+	public:
+		using ThreadPoolT	= thread_pool_public;
+		using CountT		= ::std::atomic<size_t>;
+		using MutexT		= ::std::mutex;
+		using ConditionVariableT = ::std::condition_variable;
+		using LockGuardT	= ::std::lock_guard<MutexT>;
+		using UniqueLockT	= ::std::unique_lock<MutexT>;
+		using DurationT		= ThreadPoolT::DurationT;
+		using FunctionT		= ThreadPoolT::FuncionT;
+		static constexpr DurationT help_interval = ::std::chrono::microseconds(100);
+
+		void add(size_t num = 1) noexcept;
+		void done() noexcept;
+		void defer(FunctionT&& function) noexcept;
+		FunctionT take_deferred() noexcept;
+		bool is_failed() const noexcept;
+		void set_exception(::std::exception_ptr exception) noexcept;
+		void wait(ThreadPoolT& pool);
+		void join() noexcept;
+
+		CountT					m_pending{ 0 };
+		::std::atomic<bool>		m_failed{ false };
+		MutexT					m_mutex;
+		ConditionVariableT		m_condition;
+		::std::exception_ptr	m_exception;
+		::std::vector<FunctionT>	m_deferred;
+	};
+
+	/**
+	 * @brief	ִ̳߳еĺһ
+	 * @note	ִϺ֪ͨ״̬; ̳߳ض (ֹͣջноܾ̭) δִʱ,
+	 *			ʱת״̬֪ͨ, 䲻ᶪʧ, ȴҲԶ
+	*/
+	template<class _TIndex, class _TFunc>
+	struct parallel_range
+	{
+		thread_pool_public*	m_pool = nullptr;
+		parallel_state*		m_state = nullptr;
+		_TIndex				m_first;
+		_TIndex				m_last;
+		size_t				m_grain = 0;
+		_TFunc*				m_function = nullptr;
+
+		parallel_range(thread_pool_public& pool, parallel_state& state, _TIndex first, _TIndex last, size_t grain, _TFunc& function) noexcept;
+		parallel_range(parallel_range&& range) noexcept;
+		parallel_range(const parallel_range& range) = delete;
+		~parallel_range() noexcept;
+
+		void operator()() noexcept;
+	};
+
+	/**
+	 * @brief	Զз
+	 * @note	ÿ grain Ԫؼһ̳߳Ƿ񼢶, ʱʣĺһ뽻̳߳, ̼߳ǰһ
+	*/
+	template<class _TIndex, class _TFunc>
+	void parallel_split(thread_pool_public& pool, parallel_state& state, _TIndex first, _TIndex last, size_t grain, _TFunc& function) noexcept;
+	template<class _TIndex, class _TFunc>
+	void parallel_invoke_range(thread_pool_public& pool, _TIndex first, _TIndex last, size_t grain, _TFunc& function);
+	template<class _TIndex>
+	size_t parallel_grain(const thread_pool_public& pool, _TIndex first, _TIndex last) noexcept;
+
+	template<class _TIndex, class _TFunc>
+	void parallel_for(thread_pool_public& pool, _TIndex first, _TIndex last, _TFunc&& function, size_t grain = 0);
+	template<class _TIter, class _TValue, class _TReduce>
+	_TValue parallel_reduce(thread_pool_public& pool, _TIter first, _TIter last, _TValue init, _TReduce&& reduce, size_t grain = 0);
+	template<class _TIter, class _TOutIter, class _TFunc>
+	_TOutIter parallel_transform(thread_pool_public& pool, _TIter first, _TIter last, _TOutIter out, _TFunc&& function, size_t grain = 0);
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+/**
+ * @file	parallel.inl
+ * @brief	HiCxx ݲģ
+ * @author	
+*/
+
+#include "parallel.h"
+
+namespace HiCxx
+{
+	inline void parallel_state::add(size_t num) noexcept
+	{
+		this->m_pending.fetch_add(num, ::std::memory_order_relaxed);
+	}
+
+	inline void parallel_state::done() noexcept
+	{
+		LockGuardT lock(this->m_mutex);
+		if (this->m_pending.fetch_sub(1, ::std::memory_order_acq_rel) == 1)
+			this->m_condition.notify_all();
+	}
+
+	inline void parallel_state::defer(FunctionT&& function) noexcept
+	{
+		{
+			LockGuardT lock(this->m_mutex);
+			this->m_deferred.push_back(::std::move(function));
+		}
+		this->m_condition.notify_all();
+	}
+
+	inline parallel_state::FunctionT parallel_state::take_deferred() noexcept
+	{
+		LockGuardT lock(this->m_mutex);
+		if (this->m_deferred.empty())
+			return FunctionT{};
+
+		FunctionT function = ::std::move(this->m_deferred.back());
+		this->m_deferred.pop_back();
+		return function;
+	}
+
+	inline bool parallel_state::is_failed() const noexcept
+	{
+		return this->m_failed.load(::std::memory_order_relaxed);
+	}
+
+	inline void parallel_state::set_exception(::std::exception_ptr exception) noexcept
+	{
+		LockGuardT lock(this->m_mutex);
+		if (!this->m_exception)
+			this->m_exception = ::std::move(exception);
+		this->m_failed = true;
+	}
+
+	inline void parallel_state::wait(ThreadPoolT& pool)
+	{
+		for (;;)
+		{
+			const bool done = this->m_pending.load(::std::memory_order_acquire) == 0;
+			if (FunctionT function = this->take_deferred())
+			{
+				function();
+				continue;
+			}
+			if (done)
+				break;
+			if (pool.run_one())
+				continue;
+
+			UniqueLockT lock(this->m_mutex);
+			this->m_condition.wait_for(lock, help_interval, [this]()
+				{
+					return this->m_pending.load(::std::memory_order_acquire) == 0 || !this->m_deferred.empty();
+				});
+		}
+
+		LockGuardT lock(this->m_mutex);
+		if (this->m_exception)
+			::std::rethrow_exception(this->m_exception);
+	}
+
+	inline void parallel_state::join() noexcept
+	{
+		for (;;)
+		{
+			const bool done = this->m_pending.load(::std::memory_order_acquire) == 0;
+			if (FunctionT function = this->take_deferred())
+			{
+				function();
+				continue;
+			}
+			if (done)
+				break;
+
+			UniqueLockT lock(this->m_mutex);
+			this->m_condition.wait(lock, [this]()
+				{
+					return this->m_pending.load(::std::memory_order_acquire) == 0 || !this->m_deferred.empty();
+				});
+		}
+		LockGuardT lock(this->m_mutex);
+	}
+
+	template<class _TIndex, class _TFunc>
+	inline parallel_range<_TIndex, _TFunc>::parallel_range(thread_pool_public& pool, parallel_state& state, _TIndex first, _TIndex last, size_t grain, _TFunc& function) noexcept
+		: m_pool(&pool), m_state(&state), m_first(first), m_last(last), m_grain(grain), m_function(&function)
+	{
+	}
+
+	template<class _TIndex, class _TFunc>
+	inline parallel_range<_TIndex, _TFunc>::parallel_range(parallel_range&& range) noexcept
+		: m_pool(range.m_pool), m_state(range.m_state), m_first(range.m_first), m_last(range.m_last), m_grain(range.m_grain), m_function(range.m_function)
+	{
+		range.m_state = nullptr;
+	}
+
+	template<class _TIndex, class _TFunc>
+	inline parallel_range<_TIndex, _TFunc>::~parallel_range() noexcept
+	{
+		if (!this->m_state)
+			return;
+
+		this->m_state->defer([pool = this->m_pool, state = this->m_state, first = this->m_first, last = this->m_last, grain = this->m_grain, function = this->m_function]()
+			{
+				parallel_split(*pool, *state, first, last, grain, *function);
+			});
+		this->m_state->done();
+	}
+
+	template<class _TIndex, class _TFunc>
+	inline void parallel_range<_TIndex, _TFunc>::operator()() noexcept
+	{
+		parallel_state* const state = this->m_state;
+		this->m_state = nullptr;
+		parallel_split(*this->m_pool, *state, this->m_first, this->m_last, this->m_grain, *this->m_function);
+		state->done();
+	}
+
+	template<class _TIndex, class _TFunc>
+	inline void parallel_split(thread_pool_public& pool, parallel_state& state, _TIndex first, _TIndex last, size_t grain, _TFunc& function) noexcept
+	{
+		try
+		{
+			while ((size_t)(last - first) > grain)
+			{
+				if (state.is_failed())
+					return;
+
+				if (pool.is_hungry())
+				{
+					const _TIndex middle = first + (last - first) / 2;
+					state.add();
+					pool.try_post(parallel_range<_TIndex, _TFunc>{ pool, state, middle, last, grain, function });
+					last = middle;
+				}
+				else
+				{
+					function(first, first + grain);
+					first += grain;
+				}
+			}
+			if (!state.is_failed())
+				function(first, last);
+		}
+		catch (...)
+		{
+			state.set_exception(::std::current_exception());
+		}
+	}
+
+	template<class _TIndex, class _TFunc>
+	inline void parallel_invoke_range(thread_pool_public& pool, _TIndex first, _TIndex last, size_t grain, _TFunc& function)
+	{
+		if (!(first < last))
+			return;
+
+		if (grain == 0)
+			grain = parallel_grain(pool, first, last);
+
+		parallel_state state;
+		parallel_split(pool, state, first, last, grain, function);
+		state.wait(pool);
+	}
+
+	template<class _TIndex>
+	inline size_t parallel_grain(const thread_pool_public& pool, _TIndex first, _TIndex last) noexcept
+	{
+		const size_t threads_num = (size_t)pool.get_datas_manager().m_threads_num + 1;
+		const size_t grain = (size_t)(last - first) / (threads_num * 32);
+		return grain ? grain : 1;
+	}
+
+	template<class _TIndex, class _TFunc>
+	inline void parallel_for(thread_pool_public& pool, _TIndex first, _TIndex last, _TFunc&& function, size_t grain)
+	{
+		auto body = [&function](_TIndex begin, _TIndex end)
+			{
+				for (; begin != end; ++begin)
+					function(begin);
+			};
+		parallel_invoke_range(pool, first, last, grain, body);
+	}
+
+	template<class _TIter, class _TValue, class _TReduce>
+	inline _TValue parallel_reduce(thread_pool_public& pool, _TIter first, _TIter last, _TValue init, _TReduce&& reduce, size_t grain)
+	{
+		::std::mutex mutex;
+		::std::optional<_TValue> total;
+		auto body = [&mutex, &total, &reduce](_TIter begin, _TIter end)
+			{
+				_TValue partial = *begin;
+				for (++begin; begin != end; ++begin)
+					partial = reduce(::std::move(partial), *begin);
+
+				::std::lock_guard<::std::mutex> lock(mutex);
+				if (total)
+					total = reduce(::std::move(*total), ::std::move(partial));
+				else
+					total.emplace(::std::move(partial));
+			};
+		parallel_invoke_range(pool, first, last, grain, body);
+		return total ? reduce(::std::move(init), ::std::move(*total)) : init;
+	}
+
+	template<class _TIter, class _TOutIter, class _TFunc>
+	inline _TOutIter parallel_transform(thread_pool_public& pool, _TIter first, _TIter last, _TOutIter out, _TFunc&& function, size_t grain)
+	{
+		auto body = [first, out, &function](_TIter begin, _TIter end)
+			{
+				_TOutIter result = out + (begin - first);
+				for (; begin != end; ++begin, ++result)
+					*result = function(*begin);
+			};
+		parallel_invoke_range(pool, first, last, grain, body);
+		return out + (last - first);
+	}
+}
\ No newline at end of file
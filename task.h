@@ -0,0 +1,203 @@
+/**
+ * @file	task.h
+ * @brief	HiCxx ģ
+ * @author	
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace HiCxx
+{
+	/**
+	 * @brief	ֻƶ
+	 * @note	С buffer_size ҿ쳣ƶĿɵöֱӴڲ, ڴ,
+	 *			 64 ֽڵĲһ task_promise
+	*/
+	class task_function
+	{
+	public:
+		static constexpr size_t buffer_size = 72;
+		struct VTableT
+		{
+			void (*m_invoke)(void* buffer);
+			void (*m_move)(void* destination, void* source) noexcept;
+			void (*m_destroy)(void* buffer) noexcept;
+		};
+		template<class _TFunc> static constexpr bool is_inline = (sizeof(_TFunc) <= buffer_size)
+			&& (alignof(_TFunc) <= alignof(::std::max_align_t)) && ::std::is_nothrow_move_constructible<_TFunc>::value;
+
+		task_function() noexcept = default;
+		task_function(::std::nullptr_t) noexcept;
+		template<class _TFunc, class = ::std::enable_if_t<!::std::is_same<::std::decay_t<_TFunc>, task_function>::value>>
+		task_function(_TFunc&& function) noexcept;
+		task_function(task_function&& function) noexcept;
+		task_function(const task_function& function) = delete;
+		~task_function() noexcept;
+
+		task_function& operator=(task_function&& function) noexcept;
+		task_function& operator=(const task_function& function) = delete;
+		task_function& operator=(::std::nullptr_t) noexcept;
+
+		explicit operator bool() const noexcept;
+		void operator()();
+		void reset() noexcept;
+
+	protected:
+		template<class _TFunc> struct InlineHandlerT
+		{
+			static void invoke(void* buffer);
+			static void move(void* destination, void* source) noexcept;
+			static void destroy(void* buffer) noexcept;
+			static constexpr VTableT vtable{ &invoke, &move, &destroy };
+		};
+		template<class _TFunc> struct HeapHandlerT
+		{
+			static void invoke(void* buffer);
+			static void move(void* destination, void* source) noexcept;
+			static void destroy(void* buffer) noexcept;
+			static constexpr VTableT vtable{ &invoke, &move, &destroy };
+		};
+
+		alignas(::std::max_align_t) unsigned char m_buffer[buffer_size];
+		const VTableT* m_vtable = nullptr;
+	};
+
+	template<class _Ret> struct task_value { using type = _Ret; };
+	template<class _Ret> struct task_value<_Ret&> { using type = _Ret*; };
+	template<> struct task_value<void> { using type = char; };
+	template<class _Ret> using task_value_t = typename task_value<_Ret>::type;
+
+	/**
+	 * @brief	Ĺ״̬
+	 * @note	ü״̬յǰ̵߳Ļ, ʱȫֳس, ȶ벻ڴ
+	*/
+	template<class _Ret> class task_state
+	{
+	public:
+		using StateT		= task_state;
+		using StatePtrT		= StateT*;
+		using ValueT		= task_value_t<_Ret>;
+		using RefNumT		= ::uint32_t;
+		using MutexT		= ::std::mutex;
+		using ConditionVariableT = ::std::condition_variable;
+		using LockGuardT	= ::std::lock_guard<MutexT>;
+		using UniqueLockT	= ::std::unique_lock<MutexT>;
+		using StateVectorT	= ::std::vector<StatePtrT>;
+		static constexpr size_t cache_capacity	= 64;
+		static constexpr size_t batch_size		= 32;
+
+		struct PoolT
+		{
+			MutexT			m_mutex;
+			StateVectorT	m_states;
+		};
+		struct CacheT
+		{
+			StateVectorT	m_states;
+
+			~CacheT() noexcept;
+		};
+
+		static StatePtrT acquire() noexcept;
+		static PoolT& get_pool() noexcept;
+		static CacheT& get_cache() noexcept;
+		static void transfer(StateVectorT& from, StateVectorT& to, size_t num) noexcept;
+
+		void add_ref() noexcept;
+		void release() noexcept;
+		bool is_ready() const noexcept;
+		void wait() noexcept;
+		template<class _TTimePoint>
+		bool wait_until(const _TTimePoint& time_point) noexcept;
+		template<class..._TArgs>
+		void set_value(_TArgs&&... args);
+		void set_exception(::std::exception_ptr exception) noexcept;
+		_Ret get();
+		void reset() noexcept;
+
+	protected:
+		void set_ready() noexcept;
+
+		::std::atomic<RefNumT>	m_refs{ 0 };
+		::std::atomic<bool>		m_ready{ false };
+		bool					m_has_value = false;
+		MutexT					m_mutex;
+		ConditionVariableT		m_condition;
+		::std::exception_ptr	m_exception;
+		alignas(ValueT) unsigned char m_value[sizeof(ValueT)];
+	};
+
+	template<class _Ret> class task_promise;
+
+	/**
+	 * @brief	, ӿ ::std::future һ
+	 * @note	޹״̬ (Ͷݱܾ) ʱ is_ready  false, wait , wait_for/wait_until  deferred,
+	 *			get ׳ no_state  ::std::future_error
+	*/
+	template<class _Ret> class task_future
+	{
+	public:
+		using StateT		= task_state<_Ret>;
+		using StatePtrT		= StateT*;
+
+		task_future() noexcept = default;
+		explicit task_future(StatePtrT state) noexcept;
+		task_future(task_future&& future) noexcept;
+		task_future(const task_future& future) = delete;
+		~task_future() noexcept;
+
+		task_future& operator=(task_future&& future) noexcept;
+		task_future& operator=(const task_future& future) = delete;
+
+		bool valid() const noexcept;
+		bool is_ready() const noexcept;
+		void wait() const noexcept;
+		template<class _TDuration>
+		::std::future_status wait_for(const _TDuration& duration) const noexcept;
+		template<class _TTimePoint>
+		::std::future_status wait_until(const _TTimePoint& time_point) const noexcept;
+		_Ret get();
+
+	protected:
+		StatePtrT m_state = nullptr;
+	};
+
+	template<class _Ret> class task_promise
+	{
+	public:
+		using StateT		= task_state<_Ret>;
+		using StatePtrT		= StateT*;
+
+		task_promise() noexcept;
+		task_promise(task_promise&& promise) noexcept;
+		task_promise(const task_promise& promise) = delete;
+		~task_promise() noexcept;
+
+		task_promise& operator=(task_promise&& promise) noexcept;
+		task_promise& operator=(const task_promise& promise) = delete;
+
+		task_future<_Ret> get_future() noexcept;
+		template<class..._TArgs>
+		void set_value(_TArgs&&... args);
+		void set_exception(::std::exception_ptr exception) noexcept;
+		template<class _TFunc>
+		void set_result(_TFunc&& function) noexcept;
+
+	protected:
+		void abandon() noexcept;
+
+		StatePtrT	m_state = nullptr;
+	};
+}
\ No newline at end of file
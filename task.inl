@@ -0,0 +1,454 @@
+/**
+ * @file	task.inl
+ * @brief	HiCxx ģ
+ * @author	
+*/
+
+#include "task.h"
+
+namespace HiCxx
+{
+	template<class _TFunc>
+	inline void task_function::InlineHandlerT<_TFunc>::invoke(void* buffer)
+	{
+		(*static_cast<_TFunc*>(buffer))();
+	}
+
+	template<class _TFunc>
+	inline void task_function::InlineHandlerT<_TFunc>::move(void* destination, void* source) noexcept
+	{
+		new(destination) _TFunc(::std::move(*static_cast<_TFunc*>(source)));
+		static_cast<_TFunc*>(source)->~_TFunc();
+	}
+
+	template<class _TFunc>
+	inline void task_function::InlineHandlerT<_TFunc>::destroy(void* buffer) noexcept
+	{
+		static_cast<_TFunc*>(buffer)->~_TFunc();
+	}
+
+	template<class _TFunc>
+	inline void task_function::HeapHandlerT<_TFunc>::invoke(void* buffer)
+	{
+		(**static_cast<_TFunc**>(buffer))();
+	}
+
+	template<class _TFunc>
+	inline void task_function::HeapHandlerT<_TFunc>::move(void* destination, void* source) noexcept
+	{
+		*static_cast<_TFunc**>(destination) = *static_cast<_TFunc**>(source);
+	}
+
+	template<class _TFunc>
+	inline void task_function::HeapHandlerT<_TFunc>::destroy(void* buffer) noexcept
+	{
+		delete *static_cast<_TFunc**>(buffer);
+	}
+
+	inline task_function::task_function(::std::nullptr_t) noexcept
+	{
+	}
+
+	template<class _TFunc, class>
+	inline task_function::task_function(_TFunc&& function) noexcept
+	{
+		using FunctionT = ::std::decay_t<_TFunc>;
+		if constexpr (is_inline<FunctionT>)
+		{
+			new(this->m_buffer) FunctionT(::std::forward<_TFunc>(function));
+			this->m_vtable = &InlineHandlerT<FunctionT>::vtable;
+		}
+		else
+		{
+			*reinterpret_cast<FunctionT**>(this->m_buffer) = new FunctionT(::std::forward<_TFunc>(function));
+			this->m_vtable = &HeapHandlerT<FunctionT>::vtable;
+		}
+	}
+
+	inline task_function::task_function(task_function&& function) noexcept
+	{
+		if (function.m_vtable)
+		{
+			function.m_vtable->m_move(this->m_buffer, function.m_buffer);
+			this->m_vtable = function.m_vtable;
+			function.m_vtable = nullptr;
+		}
+	}
+
+	inline task_function::~task_function() noexcept
+	{
+		this->reset();
+	}
+
+	inline task_function& task_function::operator=(task_function&& function) noexcept
+	{
+		if (this != &function)
+		{
+			this->reset();
+			if (function.m_vtable)
+			{
+				function.m_vtable->m_move(this->m_buffer, function.m_buffer);
+				this->m_vtable = function.m_vtable;
+				function.m_vtable = nullptr;
+			}
+		}
+		return *this;
+	}
+
+	inline task_function& task_function::operator=(::std::nullptr_t) noexcept
+	{
+		this->reset();
+		return *this;
+	}
+
+	inline task_function::operator bool() const noexcept
+	{
+		return this->m_vtable != nullptr;
+	}
+
+	inline void task_function::operator()()
+	{
+		this->m_vtable->m_invoke(this->m_buffer);
+	}
+
+	inline void task_function::reset() noexcept
+	{
+		if (this->m_vtable)
+		{
+			this->m_vtable->m_destroy(this->m_buffer);
+			this->m_vtable = nullptr;
+		}
+	}
+
+	template<class _Ret>
+	inline task_state<_Ret>::CacheT::~CacheT() noexcept
+	{
+		PoolT& pool = get_pool();
+		LockGuardT lock(pool.m_mutex);
+		transfer(this->m_states, pool.m_states, this->m_states.size());
+	}
+
+	template<class _Ret>
+	inline typename task_state<_Ret>::StatePtrT task_state<_Ret>::acquire() noexcept
+	{
+		CacheT& cache = get_cache();
+		if (cache.m_states.empty())
+		{
+			PoolT& pool = get_pool();
+			LockGuardT lock(pool.m_mutex);
+			transfer(pool.m_states, cache.m_states, batch_size);
+		}
+
+		StatePtrT state;
+		if (cache.m_states.empty())
+		{
+			state = new StateT{};
+		}
+		else
+		{
+			state = cache.m_states.back();
+			cache.m_states.pop_back();
+		}
+		state->m_refs.store(1, ::std::memory_order_relaxed);
+		return state;
+	}
+
+	template<class _Ret>
+	inline typename task_state<_Ret>::PoolT& task_state<_Ret>::get_pool() noexcept
+	{
+		static PoolT& pool = *new PoolT{};
+		return pool;
+	}
+
+	template<class _Ret>
+	inline typename task_state<_Ret>::CacheT& task_state<_Ret>::get_cache() noexcept
+	{
+		static thread_local CacheT cache;
+		return cache;
+	}
+
+	template<class _Ret>
+	inline void task_state<_Ret>::transfer(StateVectorT& from, StateVectorT& to, size_t num) noexcept
+	{
+		if (num > from.size())
+			num = from.size();
+		if (to.capacity() < cache_capacity + batch_size)
+			to.reserve(cache_capacity + batch_size);
+		to.insert(to.end(), from.end() - num, from.end());
+		from.erase(from.end() - num, from.end());
+	}
+
+	template<class _Ret>
+	inline void task_state<_Ret>::add_ref() noexcept
+	{
+		this->m_refs.fetch_add(1, ::std::memory_order_relaxed);
+	}
+
+	template<class _Ret>
+	inline void task_state<_Ret>::release() noexcept
+	{
+		if (this->m_refs.fetch_sub(1, ::std::memory_order_acq_rel) != 1)
+			return;
+
+		this->reset();
+		CacheT& cache = get_cache();
+		if (cache.m_states.capacity() == 0)
+			cache.m_states.reserve(cache_capacity + batch_size);
+		cache.m_states.push_back(this);
+		if (cache.m_states.size() > cache_capacity)
+		{
+			PoolT& pool = get_pool();
+			LockGuardT lock(pool.m_mutex);
+			transfer(cache.m_states, pool.m_states, batch_size);
+		}
+	}
+
+	template<class _Ret>
+	inline bool task_state<_Ret>::is_ready() const noexcept
+	{
+		return this->m_ready.load(::std::memory_order_acquire);
+	}
+
+	template<class _Ret>
+	inline void task_state<_Ret>::wait() noexcept
+	{
+		if (this->is_ready())
+			return;
+
+		UniqueLockT lock(this->m_mutex);
+		this->m_condition.wait(lock, [this]() { return this->is_ready(); });
+	}
+
+	template<class _Ret>
+	template<class _TTimePoint>
+	inline bool task_state<_Ret>::wait_until(const _TTimePoint& time_point) noexcept
+	{
+		if (this->is_ready())
+			return true;
+
+		UniqueLockT lock(this->m_mutex);
+		return this->m_condition.wait_until(lock, time_point, [this]() { return this->is_ready(); });
+	}
+
+	template<class _Ret>
+	template<class..._TArgs>
+	inline void task_state<_Ret>::set_value(_TArgs&&... args)
+	{
+		if constexpr (::std::is_reference<_Ret>::value)
+			new(this->m_value) ValueT(&args...);
+		else if constexpr (!::std::is_void<_Ret>::value)
+			new(this->m_value) ValueT(::std::forward<_TArgs>(args)...);
+		this->m_has_value = true;
+		this->set_ready();
+	}
+
+	template<class _Ret>
+	inline void task_state<_Ret>::set_exception(::std::exception_ptr exception) noexcept
+	{
+		this->m_exception = ::std::move(exception);
+		this->set_ready();
+	}
+
+	template<class _Ret>
+	inline _Ret task_state<_Ret>::get()
+	{
+		if (this->m_exception)
+			::std::rethrow_exception(this->m_exception);
+
+		if constexpr (::std::is_reference<_Ret>::value)
+			return **reinterpret_cast<ValueT*>(this->m_value);
+		else if constexpr (!::std::is_void<_Ret>::value)
+			return ::std::move(*reinterpret_cast<ValueT*>(this->m_value));
+	}
+
+	template<class _Ret>
+	inline void task_state<_Ret>::reset() noexcept
+	{
+		if (this->m_has_value)
+		{
+			reinterpret_cast<ValueT*>(this->m_value)->~ValueT();
+			this->m_has_value = false;
+		}
+		this->m_exception = nullptr;
+		this->m_ready.store(false, ::std::memory_order_relaxed);
+	}
+
+	template<class _Ret>
+	inline void task_state<_Ret>::set_ready() noexcept
+	{
+		{
+			LockGuardT lock(this->m_mutex);
+			this->m_ready.store(true, ::std::memory_order_release);
+		}
+		this->m_condition.notify_all();
+	}
+
+	template<class _Ret>
+	inline task_future<_Ret>::task_future(StatePtrT state) noexcept
+		: m_state(state)
+	{
+	}
+
+	template<class _Ret>
+	inline task_future<_Ret>::task_future(task_future&& future) noexcept
+		: m_state(future.m_state)
+	{
+		future.m_state = nullptr;
+	}
+
+	template<class _Ret>
+	inline task_future<_Ret>::~task_future() noexcept
+	{
+		if (this->m_state)
+			this->m_state->release();
+	}
+
+	template<class _Ret>
+	inline task_future<_Ret>& task_future<_Ret>::operator=(task_future&& future) noexcept
+	{
+		if (this != &future)
+		{
+			if (this->m_state)
+				this->m_state->release();
+			this->m_state = future.m_state;
+			future.m_state = nullptr;
+		}
+		return *this;
+	}
+
+	template<class _Ret>
+	inline bool task_future<_Ret>::valid() const noexcept
+	{
+		return this->m_state != nullptr;
+	}
+
+	template<class _Ret>
+	inline bool task_future<_Ret>::is_ready() const noexcept
+	{
+		return this->m_state && this->m_state->is_ready();
+	}
+
+	template<class _Ret>
+	inline void task_future<_Ret>::wait() const noexcept
+	{
+		if (this->m_state)
+			this->m_state->wait();
+	}
+
+	template<class _Ret>
+	template<class _TDuration>
+	inline ::std::future_status task_future<_Ret>::wait_for(const _TDuration& duration) const noexcept
+	{
+		return this->wait_until(::std::chrono::steady_clock::now() + duration);
+	}
+
+	template<class _Ret>
+	template<class _TTimePoint>
+	inline ::std::future_status task_future<_Ret>::wait_until(const _TTimePoint& time_point) const noexcept
+	{
+		if (!this->m_state)
+			return ::std::future_status::deferred;
+		return this->m_state->wait_until(time_point) ? ::std::future_status::ready : ::std::future_status::timeout;
+	}
+
+	template<class _Ret>
+	inline _Ret task_future<_Ret>::get()
+	{
+		struct ReleaserT
+		{
+			StatePtrT m_state;
+			~ReleaserT() noexcept { this->m_state->release(); }
+		};
+
+		if (!this->m_state)
+			throw ::std::future_error(::std::future_errc::no_state);
+		this->m_state->wait();
+		ReleaserT releaser{ this->m_state };
+		this->m_state = nullptr;
+		return releaser.m_state->get();
+	}
+
+	template<class _Ret>
+	inline task_promise<_Ret>::task_promise() noexcept
+		: m_state(StateT::acquire())
+	{
+	}
+
+	template<class _Ret>
+	inline task_promise<_Ret>::task_promise(task_promise&& promise) noexcept
+		: m_state(promise.m_state)
+	{
+		promise.m_state = nullptr;
+	}
+
+	template<class _Ret>
+	inline task_promise<_Ret>::~task_promise() noexcept
+	{
+		this->abandon();
+	}
+
+	template<class _Ret>
+	inline task_promise<_Ret>& task_promise<_Ret>::operator=(task_promise&& promise) noexcept
+	{
+		if (this != &promise)
+		{
+			this->abandon();
+			this->m_state = promise.m_state;
+			promise.m_state = nullptr;
+		}
+		return *this;
+	}
+
+	template<class _Ret>
+	inline task_future<_Ret> task_promise<_Ret>::get_future() noexcept
+	{
+		this->m_state->add_ref();
+		return task_future<_Ret>{ this->m_state };
+	}
+
+	template<class _Ret>
+	template<class..._TArgs>
+	inline void task_promise<_Ret>::set_value(_TArgs&&... args)
+	{
+		this->m_state->set_value(::std::forward<_TArgs>(args)...);
+		this->m_state->release();
+		this->m_state = nullptr;
+	}
+
+	template<class _Ret>
+	inline void task_promise<_Ret>::set_exception(::std::exception_ptr exception) noexcept
+	{
+		this->m_state->set_exception(::std::move(exception));
+		this->m_state->release();
+		this->m_state = nullptr;
+	}
+
+	template<class _Ret>
+	template<class _TFunc>
+	inline void task_promise<_Ret>::set_result(_TFunc&& function) noexcept
+	{
+		try
+		{
+			if constexpr (::std::is_void<_Ret>::value)
+			{
+				::std::forward<_TFunc>(function)();
+				this->set_value();
+			}
+			else
+			{
+				this->set_value(::std::forward<_TFunc>(function)());
+			}
+		}
+		catch (...)
+		{
+			this->set_exception(::std::current_exception());
+		}
+	}
+
+	template<class _Ret>
+	inline void task_promise<_Ret>::abandon() noexcept
+	{
+		if (this->m_state)
+			this->set_exception(::std::make_exception_ptr(::std::future_error(::std::future_errc::broken_promise)));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+/**
+ * @file	task_graph.h
+ * @brief	HiCxx ͼģ
+ * @author	
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+#include "task.h"
+#include "thread_pool.h"
+#include "parallel.h"
+
+namespace HiCxx
+{
+	/**
+	 * @brief	޻ͼ
+	 * @note	ڵ߽ظ, ÿֻýڵϵǰ, ·ڴ;
+	 *			ڵʱĺֱӷ뵱ǰ̵߳ıض;
+	 *			ͼл (Ի) ʱ run ִκνڵ, wait ׳ ::std::invalid_argument;
+	 *			̳߳ضĽڵתȴִ߳, ʹ wait Զ
+	*/
+	class task_graph
+	{
+	public:
+		using ThreadPoolT	= thread_pool_public;
+		using NodeIdT		= size_t;
+		using CountT		= ::std::atomic<size_t>;
+		using FuncionT		= task_function;
+		using NodeIdVectorT	= ::std::vector<NodeIdT>;
+
+		struct NodeT
+		{
+			FuncionT		m_function;
+			NodeIdVectorT	m_successors;
+			size_t			m_predecessors_num = 0;
+			CountT			m_pending{ 0 };
+		};
+		using NodeDequeT	= ::std::deque<NodeT>;
+
+		/**
+		 * @brief	ִ̳߳еĽڵ, δִмʱѽڵתȴ߳
+		*/
+		struct NodeTaskT
+		{
+			task_graph*		m_graph = nullptr;
+			ThreadPoolT*	m_pool = nullptr;
+			NodeIdT			m_id = 0;
+
+			NodeTaskT(task_graph* graph, ThreadPoolT* pool, NodeIdT id) noexcept;
+			NodeTaskT(NodeTaskT&& task) noexcept;
+			NodeTaskT(const NodeTaskT& task) = delete;
+			~NodeTaskT() noexcept;
+
+			void operator()() noexcept;
+		};
+
+		task_graph() noexcept = default;
+		task_graph(const task_graph& graph) = delete;
+		~task_graph() noexcept;
+
+		task_graph& operator=(const task_graph& graph) = delete;
+
+		template<class _TFunc>
+		NodeIdT emplace(_TFunc&& function) noexcept;
+		void precede(NodeIdT from, NodeIdT to) noexcept;
+		void clear() noexcept;
+
+		size_t get_nodes_num() const noexcept;
+		bool is_done() const noexcept;
+
+		void run(ThreadPoolT& pool) noexcept;
+		void wait(ThreadPoolT& pool);
+		void run_and_wait(ThreadPoolT& pool);
+
+	protected:
+		void run_node(ThreadPoolT& pool, NodeIdT id) noexcept;
+		bool is_acyclic() noexcept;
+
+		NodeDequeT		m_nodes;
+		NodeIdVectorT	m_roots;
+		parallel_state	m_state;
+		bool			m_checked = true;
+		bool			m_acyclic = true;
+	};
+}
@@ -0,0 +1,156 @@
+/**
+ * @file	task_graph.inl
+ * @brief	HiCxx ͼģ
+ * @author	
+*/
+
+#include "task_graph.h"
+
+namespace HiCxx
+{
+	inline task_graph::NodeTaskT::NodeTaskT(task_graph* graph, ThreadPoolT* pool, NodeIdT id) noexcept
+		: m_graph(graph), m_pool(pool), m_id(id)
+	{
+	}
+
+	inline task_graph::NodeTaskT::NodeTaskT(NodeTaskT&& task) noexcept
+		: m_graph(task.m_graph), m_pool(task.m_pool), m_id(task.m_id)
+	{
+		task.m_graph = nullptr;
+	}
+
+	inline task_graph::NodeTaskT::~NodeTaskT() noexcept
+	{
+		if (this->m_graph)
+			this->m_graph->m_state.defer([graph = this->m_graph, pool = this->m_pool, id = this->m_id]() { graph->run_node(*pool, id); });
+	}
+
+	inline void task_graph::NodeTaskT::operator()() noexcept
+	{
+		task_graph* const graph = this->m_graph;
+		this->m_graph = nullptr;
+		graph->run_node(*this->m_pool, this->m_id);
+	}
+
+	inline task_graph::~task_graph() noexcept
+	{
+		this->m_state.join();
+	}
+
+	template<class _TFunc>
+	inline task_graph::NodeIdT task_graph::emplace(_TFunc&& function) noexcept
+	{
+		const NodeIdT id = this->m_nodes.size();
+		this->m_nodes.emplace_back();
+		this->m_nodes.back().m_function = ::std::forward<_TFunc>(function);
+		this->m_roots.push_back(id);
+		return id;
+	}
+
+	inline void task_graph::precede(NodeIdT from, NodeIdT to) noexcept
+	{
+		NodeT& node = this->m_nodes[to];
+		this->m_nodes[from].m_successors.push_back(to);
+		if (node.m_predecessors_num++ == 0)
+			this->m_roots.erase(::std::find(this->m_roots.begin(), this->m_roots.end(), to));
+		this->m_checked = false;
+	}
+
+	inline void task_graph::clear() noexcept
+	{
+		this->m_nodes.clear();
+		this->m_roots.clear();
+		this->m_checked = true;
+		this->m_acyclic = true;
+	}
+
+	inline size_t task_graph::get_nodes_num() const noexcept
+	{
+		return this->m_nodes.size();
+	}
+
+	inline bool task_graph::is_done() const noexcept
+	{
+		return this->m_state.m_pending.load(::std::memory_order_acquire) == 0;
+	}
+
+	inline void task_graph::run(ThreadPoolT& pool) noexcept
+	{
+		if (this->m_nodes.empty())
+			return;
+
+		this->m_state.m_exception = nullptr;
+		this->m_state.m_failed = false;
+		if (!this->is_acyclic())
+		{
+			this->m_state.set_exception(::std::make_exception_ptr(::std::invalid_argument("task_graph contains a cycle")));
+			return;
+		}
+
+		for (NodeT& node : this->m_nodes)
+			node.m_pending.store(node.m_predecessors_num, ::std::memory_order_relaxed);
+		this->m_state.add(this->m_nodes.size());
+
+		for (NodeIdT id : this->m_roots)
+			pool.post(NodeTaskT{ this, &pool, id });
+	}
+
+	inline void task_graph::wait(ThreadPoolT& pool)
+	{
+		this->m_state.wait(pool);
+	}
+
+	inline void task_graph::run_and_wait(ThreadPoolT& pool)
+	{
+		this->run(pool);
+		this->wait(pool);
+	}
+
+	inline void task_graph::run_node(ThreadPoolT& pool, NodeIdT id) noexcept
+	{
+		NodeT& node = this->m_nodes[id];
+		if (!this->m_state.is_failed())
+		{
+			try
+			{
+				node.m_function();
+			}
+			catch (...)
+			{
+				this->m_state.set_exception(::std::current_exception());
+			}
+		}
+
+		for (NodeIdT successor : node.m_successors)
+		{
+			if (this->m_nodes[successor].m_pending.fetch_sub(1, ::std::memory_order_acq_rel) == 1)
+				pool.post_local(NodeTaskT{ this, &pool, successor });
+		}
+		this->m_state.done();
+	}
+
+	inline bool task_graph::is_acyclic() noexcept
+	{
+		if (this->m_checked)
+			return this->m_acyclic;
+
+		for (NodeT& node : this->m_nodes)
+			node.m_pending.store(node.m_predecessors_num, ::std::memory_order_relaxed);
+		NodeIdVectorT ready(this->m_roots);
+		size_t visited = 0;
+		while (!ready.empty())
+		{
+			const NodeIdT id = ready.back();
+			ready.pop_back();
+			++visited;
+			for (NodeIdT successor : this->m_nodes[id].m_successors)
+			{
+				if (this->m_nodes[successor].m_pending.fetch_sub(1, ::std::memory_order_relaxed) == 1)
+					ready.push_back(successor);
+			}
+		}
+		this->m_checked = true;
+		this->m_acyclic = visited == this->m_nodes.size();
+		return this->m_acyclic;
+	}
+}
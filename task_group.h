@@ -0,0 +1,93 @@
+/**
+ * @file	task_group.h
+ * @brief	HiCxx ģ
+ * @author	
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+#include "thread_pool.h"
+
+namespace HiCxx
+{
+	/**
+	 * @brief	ֻȴ
+	 * @note	һԭӼ, ʱ (ִϡȡձ) һ,
+	 *			ֻмһμѵȴ, ̳߳е޹;
+	 *			help Ϊ true ʱȴ߳ȴΪִ̳߳Ŷӵ, ȡŶ,
+	 *			ڹ߳ϵȴʱӦʹôģʽ, й̶߳ڵȴִ;
+	 *			ʱȴȫ
+	*/
+	class task_group
+	{
+	public:
+		using ThreadPoolT	= thread_pool_public;
+		using CountT		= ::std::atomic<size_t>;
+		using PriorityT		= ThreadPoolT::PriorityT;
+		using ClockT		= ThreadPoolT::ClockT;
+		using DurationT		= ThreadPoolT::DurationT;
+		using MutexT		= ::std::mutex;
+		using ConditionVariableT = ::std::condition_variable;
+		using LockGuardT	= ::std::lock_guard<MutexT>;
+		using UniqueLockT	= ::std::unique_lock<MutexT>;
+		template<class _Ret> using FutureT = ThreadPoolT::FutureT<_Ret>;
+		static constexpr DurationT help_interval = ::std::chrono::microseconds(100);
+
+		/**
+		 * @brief	һͬƶ, ʱ֪ͨ
+		*/
+		struct CompletionT
+		{
+			task_group*		m_group = nullptr;
+
+			CompletionT(task_group* group) noexcept;
+			CompletionT(CompletionT&& completion) noexcept;
+			CompletionT(const CompletionT& completion) = delete;
+			~CompletionT() noexcept;
+		};
+
+		explicit task_group(ThreadPoolT& pool) noexcept;
+		task_group(const task_group& group) = delete;
+		~task_group() noexcept;
+
+		task_group& operator=(const task_group& group) = delete;
+
+		template<class _TFunc, class..._TArgs>
+		auto submit(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit(_TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto post(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto post(_TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+
+		ThreadPoolT& get_pool() const noexcept;
+		size_t get_pending_num() const noexcept;
+		bool is_done() const noexcept;
+
+		void wait(bool help = false) noexcept;
+		template<class _TTimePoint>
+		bool wait_until(const _TTimePoint& time_point, bool help = false) noexcept;
+		template<class _TDuration>
+		bool wait_for(const _TDuration& duration, bool help = false) noexcept;
+
+	protected:
+		template<class _TFunc>
+		auto wrap(_TFunc&& function) noexcept;
+		void done() noexcept;
+
+		ThreadPoolT&		m_pool;
+		CountT				m_pending{ 0 };
+		MutexT				m_mutex;
+		ConditionVariableT	m_condition;
+	};
+}
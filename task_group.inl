@@ -0,0 +1,155 @@
+/**
+ * @file	task_group.inl
+ * @brief	HiCxx ģ
+ * @author	
+*/
+
+#include "task_group.h"
+
+namespace HiCxx
+{
+	inline task_group::CompletionT::CompletionT(task_group* group) noexcept
+		: m_group(group)
+	{
+	}
+
+	inline task_group::CompletionT::CompletionT(CompletionT&& completion) noexcept
+		: m_group(completion.m_group)
+	{
+		completion.m_group = nullptr;
+	}
+
+	inline task_group::CompletionT::~CompletionT() noexcept
+	{
+		if (this->m_group)
+			this->m_group->done();
+	}
+
+	inline task_group::task_group(ThreadPoolT& pool) noexcept
+		: m_pool(pool)
+	{
+	}
+
+	inline task_group::~task_group() noexcept
+	{
+		this->wait();
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto task_group::submit(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->m_pool.submit(priority, this->wrap(::std::forward<_TFunc>(function)), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto task_group::submit(_TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit((PriorityT)0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto task_group::post(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->m_pool.post(priority, this->wrap(::std::forward<_TFunc>(function)), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto task_group::post(_TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post((PriorityT)0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	inline task_group::ThreadPoolT& task_group::get_pool() const noexcept
+	{
+		return this->m_pool;
+	}
+
+	inline size_t task_group::get_pending_num() const noexcept
+	{
+		return this->m_pending.load(::std::memory_order_acquire);
+	}
+
+	inline bool task_group::is_done() const noexcept
+	{
+		return this->get_pending_num() == 0;
+	}
+
+	inline void task_group::wait(bool help) noexcept
+	{
+		while (!this->is_done())
+		{
+			if (help && this->m_pool.run_one())
+				continue;
+
+			UniqueLockT lock(this->m_mutex);
+			if (help)
+				this->m_condition.wait_for(lock, help_interval, [this]() { return this->is_done(); });
+			else
+				this->m_condition.wait(lock, [this]() { return this->is_done(); });
+		}
+		LockGuardT lock(this->m_mutex);
+	}
+
+	template<class _TTimePoint>
+	inline bool task_group::wait_until(const _TTimePoint& time_point, bool help) noexcept
+	{
+		while (!this->is_done())
+		{
+			if (help && this->m_pool.run_one())
+			{
+				if (_TTimePoint::clock::now() >= time_point)
+					return false;
+				continue;
+			}
+
+			UniqueLockT lock(this->m_mutex);
+			if (help)
+			{
+				const _TTimePoint help_time_point = _TTimePoint::clock::now() + help_interval;
+				this->m_condition.wait_until(lock, (::std::min)(time_point, help_time_point), [this]() { return this->is_done(); });
+			}
+			else
+			{
+				this->m_condition.wait_until(lock, time_point, [this]() { return this->is_done(); });
+			}
+			if (!this->is_done() && _TTimePoint::clock::now() >= time_point)
+				return false;
+		}
+		LockGuardT lock(this->m_mutex);
+		return true;
+	}
+
+	template<class _TDuration>
+	inline bool task_group::wait_for(const _TDuration& duration, bool help) noexcept
+	{
+		return this->wait_until(ClockT::now() + duration, help);
+	}
+
+	template<class _TFunc>
+	inline auto task_group::wrap(_TFunc&& function) noexcept
+	{
+		this->m_pending.fetch_add(1, ::std::memory_order_relaxed);
+		return [completion = CompletionT{ this }, function = ::std::forward<_TFunc>(function)](auto&&... args) mutable -> decltype(auto)
+		{
+			return ::std::move(function)(::std::forward<decltype(args)>(args)...);
+		};
+	}
+
+	inline void task_group::done() noexcept
+	{
+		size_t pending = this->m_pending.load(::std::memory_order_relaxed);
+		while (pending > 1)
+		{
+			if (this->m_pending.compare_exchange_weak(pending, pending - 1, ::std::memory_order_acq_rel, ::std::memory_order_relaxed))
+				return;
+		}
+
+		LockGuardT lock(this->m_mutex);
+		if (this->m_pending.fetch_sub(1, ::std::memory_order_acq_rel) == 1)
+			this->m_condition.notify_all();
+	}
+}
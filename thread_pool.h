@@ -6,10 +6,25 @@
 
 #pragma once
 
+#include <algorithm>
 #include <future>
+#include <thread>
 #include <vector>
-#include <set>
+#include <deque>
 #include <unordered_map>
+#include <tuple>
+#include <memory>
+#include <string>
+
+#include "hicxx_defines.h"
+#include "task.h"
+#include "timing_wheel.h"
+#include "cpu_topology.h"
+#include "histogram.h"
+
+#ifdef _HICXX_COROUTINE
+#include <coroutine>
+#endif
 
 namespace HiCxx
 {
@@ -20,64 +35,610 @@ namespace HiCxx
 		using ThreadNumT			= ::int32_t;
 		using AtomicThreadNumT		= ::std::atomic<ThreadNumT>;
 		using TaskNumT				= ::uint32_t;
+		using AtomicTaskNumT		= ::std::atomic<TaskNumT>;
 		using ClockT				= ::std::chrono::steady_clock;
 		using TimePointT			= ClockT::time_point;
 		using DurationT				= ClockT::duration;
 		using PriorityT				= int;
-		using FuncionT				= ::std::function<void()>;
+		using CounterT				= ::uint64_t;
+		using AtomicCounterT		= ::std::atomic<CounterT>;
+		using FuncionT				= task_function;
+		using SharedFunctionT		= ::std::shared_ptr<FuncionT>;
 		using MutexT				= ::std::mutex;
 		using ConditionVariableT	= ::std::condition_variable;
-		template<class _Ret> using PackagedTaskT	= ::std::packaged_task<_Ret()>;
-		template<class _Ret> using FutureT			= ::std::future<_Ret>;
+		template<class _Ret> using PromiseT			= task_promise<_Ret>;
+		template<class _Ret> using FutureT			= task_future<_Ret>;
 		using UniqueLockT			= ::std::unique_lock<MutexT>;
 		using LockGuardT			= ::std::lock_guard<MutexT>;
+		static constexpr size_t		cache_line_size	= 64;
 
 		struct TaskT;
-		using TaskSetT				= ::std::multiset<TaskT, ::std::greater<TaskT>>;
+		struct TaskRingT;
+		struct TaskQueueT;
+		struct CancelStateT;
+		using CancelStatePtrT		= ::std::shared_ptr<CancelStateT>;
+		struct QueueT;
+		using QueueIdT				= size_t;
+		using QueuePtrT				= ::std::unique_ptr<QueueT>;
+		static constexpr QueueIdT	queue_npos		= (QueueIdT)-1;
+		static constexpr size_t		queues_max		= 64;
+		using TaskVectorT			= ::std::vector<TaskT>;
+		using TaskDequeT			= ::std::deque<TaskT>;
+		using LevelBitmapT			= ::uint64_t;
 
 		using ThreadT				= ::std::thread;
 		struct ThreadPackT;
 		using ThreadPtrT			= ThreadPackT*;
+		using AtomicThreadPtrT		= ::std::atomic<ThreadPtrT>;
 		using ThreadMapT			= ::std::unordered_map<ThreadT::id, ThreadPtrT>;
-		
-		struct ThreadPackT
-		{
-			ThreadT m_thread;
-			bool m_enable;
-		};
 		struct TaskT
 		{
 			FuncionT	m_function{};
 			TimePointT	m_expiration_time{};
 			PriorityT	m_priority = 0;
 			bool		m_submit_on_expiration = false;
+			::uint32_t	m_epoch = 0;
+			::uint32_t	m_sequence = 0;
+			QueueT*		m_queue = nullptr;
+			CancelStatePtrT	m_cancel{};
+#ifdef _HICXX_TASK_TIMESTAMP
+			TimePointT	m_enqueue_time{};
+#endif
+#ifdef _HICXX_TRACE
+			const char*	m_label = nullptr;
+#endif
 
+			bool has_deadline() const noexcept;
 			constexpr bool operator<(const TaskT& task) const noexcept;
 			constexpr bool operator>(const TaskT& task) const noexcept;
 		};
-		
+		/**
+		 * @brief	ȼϵȽȳζ
+		*/
+		struct TaskRingT
+		{
+			TaskVectorT	m_tasks;
+			size_t		m_head = 0;
+			size_t		m_size = 0;
+
+			bool empty() const noexcept;
+			size_t size() const noexcept;
+			TaskT& front() noexcept;
+			const TaskT& front() const noexcept;
+			const TaskT& back() const noexcept;
+			void push(TaskT&& task) noexcept;
+			void pop(TaskT& task) noexcept;
+			void pop_back(TaskT& task) noexcept;
+			void clear() noexcept;
+			size_t purge(const TimePointT& now, TimePointT& earliest) noexcept;
+		};
+		/**
+		 * @brief	ȼϻ
+		 * @note	m_interval ΪһԪĳ, Ϊ 0 ʱرϻ; ÿŶһԪ, Чȼһ;
+		 *			m_max_wait Ϊ 0 ʱ, Ŷӳʱ (Ԫȡ) ȼȳ
+		*/
+		struct AgingT
+		{
+			DurationT			m_interval{};
+			DurationT			m_max_wait{};
+		};
+		/**
+		 * @brief	ȼͰ
+		 * @note	ȼ [priority_min, priority_max] , ÿȼһζ, ͬһȼȽȳ,
+		 *			λͼ¼ǿյȼ, ӾΪ O(1);
+		 *			EDF ģʽ´ֹʱķڰֹʱС, ֹʱͬʱȼǰ,
+		 *			еͰе;
+		 *			ϻģʽʱ¼ǰԪ, ÿͰĶ׼Ͱϵ, ʱֻȽϸǿͰ׵
+		 *			"ȼ + ŶӼԪ", Ŷ, Ϊ O(ǿͰ)
+		*/
+		struct TaskQueueT
+		{
+			static constexpr PriorityT	priority_min	= -32;
+			static constexpr PriorityT	priority_max	= 31;
+			static constexpr size_t		levels_num		= (size_t)(priority_max - priority_min + 1);
+
+			TaskRingT		m_levels[levels_num];
+			LevelBitmapT	m_bitmap = 0;
+			size_t			m_size = 0;
+			TaskVectorT		m_deadlines;
+			bool			m_edf = false;
+			DurationT		m_aging_interval{};
+			::uint32_t		m_max_age = 0;
+			::uint32_t		m_epoch = 0;
+			TimePointT		m_epoch_time{};
+
+			static size_t get_level(PriorityT priority) noexcept;
+			static size_t get_highest_level(LevelBitmapT bitmap) noexcept;
+			static bool is_later(const TaskT& task1, const TaskT& task2) noexcept;
+			void set_edf(bool edf) noexcept;
+			void set_aging(const AgingT& aging) noexcept;
+			void update_epoch() noexcept;
+			size_t get_top_level() const noexcept;
+			size_t get_lowest_level() const noexcept;
+			size_t get_oldest_level() const noexcept;
+			void insert(TaskT&& task) noexcept;
+			void evict(size_t level, bool oldest, TaskT& task) noexcept;
+
+			bool empty() const noexcept;
+			size_t size() const noexcept;
+			const TaskT& top() const noexcept;
+			void push(TaskT&& task) noexcept;
+			void pop(TaskT& task) noexcept;
+			void clear() noexcept;
+			size_t purge(const TimePointT& now, TimePointT& earliest) noexcept;
+		};
+		/**
+		 * @brief	ȡ״̬
+		 * @note	queued Ŷ; running ִ; cancelling ִȡ,  is_cancel_requested ѯ;
+		 *			cancelled ʼǰѱȡ; finished ִ, ձ
+		*/
+		enum class CancelStatusT : ::uint8_t
+		{
+			queued,
+			running,
+			cancelling,
+			cancelled,
+			finished
+		};
+		/**
+		 * @note	Ŷڼ m_function , ֻ³б״̬Ŀ;
+		 *			m_status 뿪 queued תֻһܳɹ, ɹһռ m_function:
+		 *			ӵĹ߳ȡִ, ȡͷ (Ӧ future õ broken_promise),
+		 *			ȡĿ m_cancelled_num, ټŶ, ʱֱӶ
+		*/
+		struct CancelStateT
+		{
+			::std::atomic<CancelStatusT>	m_status{ CancelStatusT::queued };
+			FuncionT						m_function;
+			ThreadPoolT*					m_pool = nullptr;
+		};
+		/**
+		 * @brief	ȡ
+		 * @note	cancel ŶеƳв true, ִеֻȡ󲢷 false; ӵ
+		*/
+		struct CancelTokenT
+		{
+			CancelStatePtrT		m_state;
+
+			bool valid() const noexcept;
+			CancelStatusT get_status() const noexcept;
+			bool cancel() const noexcept;
+		};
+		struct CancelGroupStateT
+		{
+			MutexT							m_mutex;
+			::std::vector<CancelStatePtrT>	m_states;
+			size_t							m_prune_size = 16;
+		};
+		/**
+		 * @brief	ȡ
+		 * @note	cancel ȡǰڵȫ, Ƴе, ֮ɼʹ;
+		 *			ڼ¼ﵽϴʱƳѽ
+		*/
+		struct CancelGroupT
+		{
+			::std::shared_ptr<CancelGroupStateT>	m_state;
+
+			bool valid() const noexcept;
+			void add(const CancelStatePtrT& state) const noexcept;
+			size_t cancel() const noexcept;
+		};
+		/**
+		 * @brief	ƽȵ
+		 * @note	һк, амȨת: ÿеĶ m_deficit ,
+		 *			ִн۳ʵʺʱ, пɵȶеĶȶþʱ quantum * m_weight ;
+		 *			m_max_running ͬʱִе, Ϊ 0 ʱ, ﵽ޵Ķݲ;
+		 *			0 ŶΪĬ϶, Դ DatasManagerT::m_tasks ; д󲻻ɾ
+		*/
+		struct QueueT
+		{
+			static constexpr DurationT	quantum = ::std::chrono::milliseconds(1);
+
+			QueueIdT			m_id = 0;
+			::std::string		m_name;
+			TaskQueueT			m_tasks;
+			::uint32_t			m_weight = 1;
+			AtomicThreadNumT	m_max_running{ 0 };
+			::std::atomic<::int64_t>	m_deficit{ 0 };
+			AtomicThreadNumT	m_running_num{ 0 };
+			AtomicCounterT		m_submitted_num{ 0 };
+			AtomicCounterT		m_executed_num{ 0 };
+			AtomicCounterT		m_busy_time{ 0 };
+#ifdef _HICXX_METRICS
+			histogram			m_wait_histogram;
+#endif
+
+			::int64_t get_quantum() const noexcept;
+			bool is_saturated() const noexcept;
+		};
+		/**
+		 * @brief	еĵȼ
+		 * @note	ʱ䵥λΪ; m_queued_num ȡδӵ
+		*/
+		struct QueueStatsT
+		{
+			QueueIdT			m_id = 0;
+			::std::string		m_name;
+			::uint32_t			m_weight = 1;
+			ThreadNumT			m_max_running = 0;
+			TaskNumT			m_queued_num = 0;
+			ThreadNumT			m_running_num = 0;
+			CounterT			m_submitted_num = 0;
+			CounterT			m_executed_num = 0;
+			CounterT			m_busy_time = 0;
+#ifdef _HICXX_METRICS
+			histogram::SnapshotT	m_wait_histogram;
+#endif
+		};
+#ifdef _HICXX_METRICS
+		/**
+		 * @brief	̵߳ĵȼ
+		 * @note	ֻڶ _HICXX_METRICS ʱͳ; ÿ̶߳ռһݲж, ǹ̹̳߳߳еһ;
+		 *			ȡʱ, ӵ; ̶߳ռһ m_exclusive Ϊ true, ֻԼд,  relaxed дԭӼ;
+		 *			m_wait_histogram Ϊӵʼִе, m_run_histogram Ϊִкʱ,
+		 *			m_contended_num Ϊȡ m_mutex ʱҪȴĴ
+		*/
+		struct alignas(cache_line_size) MetricsT
+		{
+			AtomicCounterT		m_executed_num{ 0 };
+			AtomicCounterT		m_busy_time{ 0 };
+			AtomicCounterT		m_stolen_num{ 0 };
+			AtomicCounterT		m_lock_num{ 0 };
+			AtomicCounterT		m_contended_num{ 0 };
+			histogram			m_wait_histogram;
+			histogram			m_run_histogram;
+			bool				m_exclusive = false;
+
+			void add(AtomicCounterT& counter, CounterT value) noexcept;
+			void record(histogram& histogram, histogram::ValueT value) noexcept;
+			void merge(const MetricsT& metrics) noexcept;
+			void clear() noexcept;
+		};
+		struct WorkerMetricsT
+		{
+			cpu_topology::CpuT	m_cpu = cpu_topology::npos;
+			bool				m_enable = false;
+			CounterT			m_executed_num = 0;
+			CounterT			m_busy_time = 0;
+			CounterT			m_stolen_num = 0;
+		};
+		/**
+		 * @brief	̳߳صȼĿ
+		 * @note	Ϊ֮߳, ʱ䵥λΪ; m_peak_tasks_num Ϊϴ󳤶;
+		 *			˳̵߳ļ, m_workers еȴõݰ m_enable Ϊ false
+		*/
+		struct MetricsSnapshotT
+		{
+			ThreadNumT					m_threads_num = 0;
+			ThreadNumT					m_running_num = 0;
+			ThreadNumT					m_idle_num = 0;
+			TaskNumT					m_shared_num = 0;
+			TaskNumT					m_local_num = 0;
+			TaskNumT					m_peak_tasks_num = 0;
+			CounterT					m_executed_num = 0;
+			CounterT					m_busy_time = 0;
+			CounterT					m_stolen_num = 0;
+			CounterT					m_lock_num = 0;
+			CounterT					m_contended_num = 0;
+			histogram::SnapshotT		m_wait_histogram;
+			histogram::SnapshotT		m_run_histogram;
+			::std::vector<WorkerMetricsT>	m_workers;
+		};
+#endif
+#ifdef _HICXX_TRACE
+		/**
+		 * @brief	һִеĸ¼
+		*/
+		struct TraceEventT
+		{
+			const char*			m_label = nullptr;
+			TimePointT			m_enqueue_time{};
+			TimePointT			m_begin_time{};
+			TimePointT			m_end_time{};
+		};
+		/**
+		 * @brief	̶߳ռĸ¼λ
+		 * @note	ֻ߳д, д󸲸ɵ¼; ʱ m_written ȡ, ,
+		 *			дͬʱʱɵļ¼ܱǳ¼
+		*/
+		struct TraceRingT
+		{
+			::std::unique_ptr<TraceEventT[]>	m_events;
+			size_t								m_capacity = 0;
+			AtomicCounterT						m_written{ 0 };
+
+			void allocate(size_t capacity) noexcept;
+			void push(const TraceEventT& event) noexcept;
+		};
+#endif
+		/**
+		 * @brief	̵߳ɼ
+		 * @note	 MetricsT ͬ, ÿ̶߳ռһݲж, ǹ߳ (run_one) ̳߳еһ,
+		 *			ȡʱ, ռһͬ relaxed дԭӼ; m_done_num ֻԶʱ
+		*/
+		struct alignas(cache_line_size) CountersT
+		{
+			AtomicCounterT		m_done_num{ 0 };
+			AtomicCounterT		m_met_num{ 0 };
+			AtomicCounterT		m_late_num{ 0 };
+			AtomicCounterT		m_dropped_num{ 0 };
+			bool				m_exclusive = false;
+
+			void add(AtomicCounterT& counter, CounterT value) noexcept;
+			void merge(const CountersT& counters) noexcept;
+			void clear() noexcept;
+		};
+		/**
+		 * @brief	̵߳ݰ
+		 * @note	ȡģʽÿ߳ӵһ˫˶, Լβȡ, ̴߳ͷȡ;
+		 *			m_local_submit ʱ (Ĭ), ʹȡģʽ, ߳ύ 0 ȼҲԼıض,
+		 *			, Լȳȡ, ߳Կɴͷȡ;
+		 *			m_cpu Ϊ󶨵 CPU (δʱΪ npos), m_node Ϊ NUMA ڵе±;
+		 *			߳ʱ˳̳߳̽߳صݼ, ݰ, ֮߳ʱ̲߳ݰ;
+		 *			ֶֻ߳뱻ȡƵдıضзִͬĻ
+		*/
+		struct ThreadPackT
+		{
+			ThreadT				m_thread;
+			::std::atomic<bool>	m_enable{ false };
+			::std::atomic<bool>	m_exited{ false };
+			ThreadPoolT*		m_pool = nullptr;
+			cpu_topology::CpuT	m_cpu = cpu_topology::npos;
+			size_t				m_node = 0;
+			AtomicThreadPtrT	m_next = nullptr;
+			alignas(cache_line_size) MutexT	m_local_mutex;
+			TaskDequeT			m_local_tasks;
+			AtomicTaskNumT		m_local_num = 0;
+			CountersT			m_counters;
+#ifdef _HICXX_METRICS
+			MetricsT			m_metrics;
+#endif
+#ifdef _HICXX_TRACE
+			ThreadNumT			m_index = 0;
+			TraceRingT			m_trace;
+#endif
+		};
+		/**
+		 * @brief	ʱеĶʱ
+		 * @note	once ںͶһ; fixed_rate ̶ƵͶ; fixed_delay һִнټʱ;
+		 *			purge Ͷ, ʱѹڵ; autoscale Ͷ, ̶Ƶڶʱ߳ϵ߳
+		*/
+		enum class TimerModeT : ::uint8_t
+		{
+			once,
+			fixed_delay,
+			fixed_rate,
+			purge,
+			autoscale
+		};
+		struct TimerT
+		{
+			FuncionT			m_function;
+			SharedFunctionT		m_periodic;
+			PriorityT			m_priority = 0;
+			TimerModeT			m_mode = TimerModeT::once;
+		};
+		using TimerWheelT			= timing_wheel<TimerT>;
+		using TimerIdT				= TimerWheelT::IdT;
+		using TimerActionT			= TimerWheelT::ActionT;
+
+		/**
+		 * @note	m_state_condition ֹͣͣͼ߳ʱȴ߳, æ;
+		 *			ȴȫɵ߳ m_waiter_num еǼ, ֻŶһ (ȡ)
+		 *			еǼʱ֪ͨ m_wait_condition, ûеȴʱ񲻼Ҳ֪ͨ;
+		 *			ʱͶ߳ m_producer_num еǼǲȴ m_space_condition, ÿʼִһһ;
+		 *			ʱ߳ʹõִͬĻ
+		*/
 		struct MutexManagerT
 		{
 			MutexT				m_mutex;
 			ConditionVariableT	m_task_condition;
 			ConditionVariableT	m_wait_condition;
+			ConditionVariableT	m_space_condition;
 			ConditionVariableT	m_pause_condition;
+			alignas(cache_line_size) MutexT	m_timer_mutex;
+			ConditionVariableT	m_timer_condition;
+			MutexT				m_state_mutex;
+			ConditionVariableT	m_state_condition;
 		};
+		/**
+		 * @note	ʷʽ, µĻпʼ:
+		 *			ǰΪ߳ÿֻ޸ĵֶκͶʱ;
+		 *			ΪĹм; ÿʼͽҪ޸ĵ m_running_num ռһ;
+		 *			ضмȴǼǸռһ; ɼȼɢ߳, ȡʱ
+		*/
 		struct DatasManagerT
 		{
 			ThreadMapT			m_threads;
-			TaskSetT			m_tasks;
-			AtomicThreadNumT	m_running_num = 0;
-			ThreadNumT			m_threads_num = 0;
-			AtomicThreadNumT	m_delete_num;
+			AtomicThreadNumT	m_threads_num = 0;
+			AtomicThreadNumT	m_delete_num = 0;
+			AtomicThreadPtrT	m_workers = nullptr;
+			::std::atomic<size_t>	m_queues_num{ 0 };
+			QueuePtrT			m_queues[queues_max];
+			cpu_topology		m_topology;
+			TimerWheelT			m_timers;
+			ThreadT				m_timer_thread;
+			TimePointT			m_timer_wake_time = TimePointT::max();
+			CounterT			m_autoscale_done_num = 0;
+			::uint32_t			m_grow_samples = 0;
+			::uint32_t			m_shrink_samples = 0;
+			TimerIdT			m_autoscale_timer{};
+			TimerIdT			m_purge_timer{};
+			::std::atomic<TimePointT>	m_purge_time{ TimePointT::max() };
+			AtomicCounterT		m_rejected_num = 0;
+			AtomicCounterT		m_evicted_num = 0;
+#ifdef _HICXX_TRACE
+			ThreadNumT			m_spawned_num = 0;
+			size_t				m_trace_capacity = 0;
+#endif
+
+			alignas(cache_line_size) TaskQueueT	m_tasks;
+			size_t				m_queue_cursor = 0;
+			::uint32_t			m_sequence = 0;
+			AtomicTaskNumT		m_shared_num = 0;
+#ifdef _HICXX_METRICS
+			AtomicTaskNumT		m_peak_tasks_num = 0;
+#endif
+
+			alignas(cache_line_size) AtomicThreadNumT	m_running_num = 0;
+
+			alignas(cache_line_size) AtomicTaskNumT	m_local_num = 0;
+			AtomicTaskNumT		m_cancelled_num = 0;
+			AtomicThreadPtrT	m_submit_cursor = nullptr;
+
+			alignas(cache_line_size) AtomicThreadNumT	m_idle_num = 0;
+			AtomicThreadNumT	m_waiter_num = 0;
+			AtomicThreadNumT	m_producer_num = 0;
+
+			CountersT			m_counters;
+			CountersT			m_retired_counters;
+#ifdef _HICXX_METRICS
+			MetricsT			m_metrics;
+			MetricsT			m_retired_metrics;
+#endif
+		};
+		/**
+		 * @brief	̵߳Ŀв
+		 * @note	ȡʱ m_spin_num  (ÿִһ pause ָ), ó m_yield_num ʱƬ,
+		 *			Ȼû; Ĭ߾Ϊ 0, ֱ
+		*/
+		struct IdlePolicyT
+		{
+			::uint32_t			m_spin_num = 0;
+			::uint32_t			m_yield_num = 0;
+		};
+		/**
+		 * @brief	ѹԶ߳
+		 * @note	ÿ m_interval һŶ߳,  Little ɹŶӵȴʱ;
+		 *			ȴ m_grow_wait æµ m_grow_utilisation Ĳ m_grow_samples ʱ m_step ߳,
+		 *			Ϊæµ m_shrink_utilisation Ĳ m_shrink_samples ʱ m_step ߳,
+		 *			߳ [m_min_num, m_max_num] , ٵ߳ͨ m_delete_num 첽˳;
+		 *			ʱ߳Ҳ߳, ʿʱǿƽ m_multi ģʽ, ʹͣ͵߳ m_mutex,
+		 *			ڼ set_multi(false) Ч
+		*/
+		struct AutoscaleT
+		{
+			bool				m_enable = false;
+			ThreadNumT			m_min_num = 1;
+			ThreadNumT			m_max_num = 1;
+			ThreadNumT			m_step = 1;
+			DurationT			m_interval = ::std::chrono::milliseconds(100);
+			DurationT			m_grow_wait = ::std::chrono::milliseconds(10);
+			double				m_grow_utilisation = 0.9;
+			double				m_shrink_utilisation = 0.5;
+			::uint32_t			m_grow_samples = 2;
+			::uint32_t			m_shrink_samples = 20;
+		};
+		/**
+		 * @brief	̵߳ķ÷ʽ
+		 * @note	none ; compact ˳ΰ, һڵ; scatter ڸ NUMA ڵ;
+		 *			˺ڵ㹤̵߳ıضмΪýڵķƬ, ȡⲿͶݾѡͬڵĹ߳;
+		 *			ֻӰ֮󴴽Ĺ߳
+		*/
+		enum class PlacementT : ::uint8_t
+		{
+			none,
+			compact,
+			scatter
+		};
+		/**
+		 * @brief	ŶﵽʱĴʽ
+		 * @note	block Ͷֱ߳пλ, ȴֹ̳ܾ߳ͣ; reject ܾ;
+		 *			drop_oldest ̭ӵ; drop_lowest ̭ȼ͵,
+		 *			ͬȼ̭ӵ, ȼʱΪܾ
+		*/
+		enum class OverflowPolicyT : ::uint8_t
+		{
+			block,
+			reject,
+			drop_oldest,
+			drop_lowest
+		};
+		/**
+		 * @brief	Ŷ
+		 * @note	m_capacity Ϊ 0 ʱ; Ŷִе, ﵽ޺ m_policy ;
+		 *			ִܾ̭,  future õ broken_promise; post ϵбܾʱ false,
+		 *			try_submitsubmit_for ܾʱ޹״̬ future;
+		 *			߳ͶʱӲ, block ʱֱӷ; ʱ *_unchecked Ͷݲ;
+		 *			ضк EDF е񲻲̭, ûп̭ʱܾ;
+		 *			Ե, ߳ͬʱͶʱ೬ͬʱͶݵ߳
+		*/
+		struct BoundT
+		{
+			TaskNumT			m_capacity = 0;
+			OverflowPolicyT		m_policy = OverflowPolicyT::block;
+		};
+		struct OverflowStatsT
+		{
+			CounterT			m_rejected_num = 0;
+			CounterT			m_evicted_num = 0;
 		};
+		/**
+		 * @note	m_stoppedm_pausingm_stealing ɹ߳ڵȡ, Ϊԭ, · relaxed ȡ;
+		 *			 run_task  m_running_num ļ, ֹͣͣд־ٶ m_running_num ,
+		 *			 seq_cst ȡ, ڴ CPU ˫ܶԷ, wait_running_done 
+		*/
 		struct StateManagerT
 		{
 			bool				m_multi = false;
 			bool				m_try_mode = true;
-			bool				m_stopped = true;
-			bool				m_pausing = false;
+			::std::atomic<bool>	m_stopped{ true };
+			::std::atomic<bool>	m_pausing{ false };
+			::std::atomic<bool>	m_stealing{ false };
+			bool				m_local_submit = true;
+			bool				m_timer_stopped = false;
+			bool				m_edf = false;
+			AgingT				m_aging{};
+			BoundT				m_bound{};
+			IdlePolicyT			m_idle_policy{};
+			PlacementT			m_placement = PlacementT::none;
+			AutoscaleT			m_autoscale{};
+#ifdef _HICXX_TRACE
+			bool				m_tracing = false;
+#endif
+		};
+		/**
+		 * @brief	ֹʱͳ
+		 * @note	ֻͳƴֹʱ: ʱʼִеļ met, ʱִеļ late, ʱļ dropped
+		*/
+		struct DeadlineStatsT
+		{
+			CounterT			m_met_num = 0;
+			CounterT			m_late_num = 0;
+			CounterT			m_dropped_num = 0;
 		};
+#ifdef _HICXX_COROUTINE
+		using HandleVectorT			= ::std::vector<::std::coroutine_handle<>>;
+		/**
+		 * @brief	co_await Э̳߳صĹ߳ϻָ
+		 * @note	ֹ̳߳ͣноܾʱڵǰֱ߳ӻָ
+		*/
+		struct ScheduleAwaiterT
+		{
+			ThreadPoolT&		m_pool;
+			PriorityT			m_priority = 0;
+
+			bool await_ready() const noexcept;
+			bool await_suspend(::std::coroutine_handle<> handle) noexcept;
+			void await_resume() const noexcept;
+		};
+		/**
+		 * @brief	ָЭ̵
+		 * @note	̳߳ض (ֹͣջноܾ̭) δִʱ, ʱЭ̼뵱ǰ̵߳Ĵָб,
+		 *			߳ͷŵٻָ, Э֡й©, ȴҲԶ
+		*/
+		struct ResumeTaskT
+		{
+			::std::coroutine_handle<>	m_handle;
+
+			explicit ResumeTaskT(::std::coroutine_handle<> handle) noexcept;
+			ResumeTaskT(ResumeTaskT&& task) noexcept;
+			ResumeTaskT(const ResumeTaskT& task) = delete;
+			~ResumeTaskT() noexcept;
+
+			void operator()() noexcept;
+		};
+#endif
 
 		thread_pool_public() noexcept = default;
 		thread_pool_public(ThreadNumT threads_num) noexcept;
@@ -97,6 +658,17 @@ namespace HiCxx
 		void set_threads_num_unchecked(ThreadNumT threads_num) noexcept;
 		void set_multi_unchecked(bool multi) noexcept;
 		void set_try_mode_unchecked(bool try_mode) noexcept;
+		void set_stealing_unchecked(bool stealing) noexcept;
+		void set_local_submit_unchecked(bool local_submit) noexcept;
+		void set_edf_unchecked(bool edf) noexcept;
+		void set_aging_unchecked(const AgingT& aging) noexcept;
+		void set_idle_policy_unchecked(const IdlePolicyT& idle_policy) noexcept;
+		void set_placement_unchecked(PlacementT placement) noexcept;
+		void set_autoscale_unchecked(const AutoscaleT& autoscale) noexcept;
+		void set_bound_unchecked(const BoundT& bound) noexcept;
+#ifdef _HICXX_TRACE
+		void set_tracing_unchecked(bool tracing, size_t capacity = (size_t)1 << 16) noexcept;
+#endif
 
 		bool resume() noexcept;
 		bool pause_no_wait() noexcept;
@@ -109,6 +681,17 @@ namespace HiCxx
 		bool set_threads_num(ThreadNumT threads_num) noexcept;
 		void set_multi(bool multi) noexcept;
 		void set_try_mode(bool try_mode) noexcept;
+		void set_stealing(bool stealing) noexcept;
+		void set_local_submit(bool local_submit) noexcept;
+		void set_edf(bool edf) noexcept;
+		void set_aging(const AgingT& aging) noexcept;
+		void set_idle_policy(const IdlePolicyT& idle_policy) noexcept;
+		void set_placement(PlacementT placement) noexcept;
+		void set_autoscale(const AutoscaleT& autoscale) noexcept;
+		void set_bound(const BoundT& bound) noexcept;
+#ifdef _HICXX_TRACE
+		void set_tracing(bool tracing, size_t capacity = (size_t)1 << 16) noexcept;
+#endif
 
 		MutexManagerT& get_mutex_manager_unchecked() noexcept;
 		DatasManagerT& get_datas_manager_unchecked() noexcept;
@@ -128,6 +711,18 @@ namespace HiCxx
 		ThreadNumT get_tasks_num() noexcept;
 		bool is_all_done_unchecked() const noexcept;
 		bool is_all_done() noexcept;
+		DeadlineStatsT get_deadline_stats() const noexcept;
+		void reset_deadline_stats() noexcept;
+		OverflowStatsT get_overflow_stats() const noexcept;
+		void reset_overflow_stats() noexcept;
+#ifdef _HICXX_METRICS
+		MetricsSnapshotT get_metrics_snapshot() const noexcept;
+		void reset_metrics() noexcept;
+#endif
+#ifdef _HICXX_TRACE
+		bool dump_trace(const char* path) const noexcept;
+		void clear_trace() noexcept;
+#endif
 
 		void wait_all_done_unchecked(bool wait_when_stop = false) noexcept;
 		template<class _TTimePoint>
@@ -167,16 +762,299 @@ namespace HiCxx
 		template<class _TFunc, class..._TArgs>
 		auto submit(_TFunc&& function, _TArgs&&... args) noexcept
 			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+
+		template<class _TFunc, class..._TArgs>
+		auto post_unchecked(const TimePointT& expiration_time, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)));
+		template<class _TFunc, class..._TArgs>
+		auto post_unchecked(const DurationT& expiration_time_length, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)));
+
+		template<class _TFunc, class..._TArgs>
+		auto post(const TimePointT& expiration_time, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto post(const DurationT& expiration_time_length, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+
+		template<class _TFunc, class..._TArgs>
+		auto post(const TimePointT& expiration_time, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto post(const DurationT& expiration_time_length, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto post(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto post(_TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
 		template<class..._TArgs>
-		auto execute(_TArgs&&... args) noexcept
-			->decltype(this->submit(::std::forward<_TArgs>(args)...));
+		void execute(_TArgs&&... args) noexcept;
+		template<class _TFunc, class..._TArgs>
+		auto post_local(_TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto submit_traced(const char* label, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit_traced(const char* label, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto post_traced(const char* label, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto post_traced(const char* label, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+
+		template<class _TFunc, class..._TArgs>
+		auto submit_cancellable(CancelTokenT& token, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit_cancellable(CancelTokenT& token, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit_cancellable(CancelTokenT& token, const CancelGroupT& group, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit_cancellable(CancelTokenT& token, const CancelGroupT& group, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto post_cancellable(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), CancelTokenT{});
+		template<class _TFunc, class..._TArgs>
+		auto post_cancellable(_TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), CancelTokenT{});
+		template<class _TFunc, class..._TArgs>
+		auto post_cancellable(const CancelGroupT& group, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), CancelTokenT{});
+		template<class _TFunc, class..._TArgs>
+		auto post_cancellable(const CancelGroupT& group, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), CancelTokenT{});
+		static CancelGroupT make_cancel_group() noexcept;
+		static bool is_cancel_requested() noexcept;
+
+		template<class _TFunc, class..._TArgs>
+		auto try_submit(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto try_submit(_TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit_for(const DurationT& duration, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit_for(const DurationT& duration, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto try_post(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto try_post(_TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto post_for(const DurationT& duration, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto post_for(const DurationT& duration, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+
+		QueueIdT create_queue(const char* name, ::uint32_t weight = 1, ThreadNumT max_running = 0) noexcept;
+		bool set_queue(QueueIdT id, ::uint32_t weight, ThreadNumT max_running = 0) noexcept;
+		QueueIdT find_queue(const char* name) noexcept;
+		::std::vector<QueueStatsT> get_queue_stats() noexcept;
+		template<class _TFunc, class..._TArgs>
+		auto submit_to(QueueIdT queue, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit_to(QueueIdT queue, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto post_to(QueueIdT queue, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+		template<class _TFunc, class..._TArgs>
+		auto post_to(QueueIdT queue, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true);
+
+		template<class _TFunc, class..._TArgs>
+		auto submit_at(const TimePointT& time, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit_at(const TimePointT& time, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit_after(const DurationT& delay, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto submit_after(const DurationT& delay, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		auto post_at(const TimePointT& time, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), TimerIdT{});
+		template<class _TFunc, class..._TArgs>
+		auto post_at(const TimePointT& time, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), TimerIdT{});
+		template<class _TFunc, class..._TArgs>
+		auto post_after(const DurationT& delay, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), TimerIdT{});
+		template<class _TFunc, class..._TArgs>
+		auto post_after(const DurationT& delay, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), TimerIdT{});
+		template<class _TFunc, class..._TArgs>
+		auto post_periodic(const DurationT& period, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(function(args...)), TimerIdT{});
+		template<class _TFunc, class..._TArgs>
+		auto post_periodic(const DurationT& period, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(function(args...)), TimerIdT{});
+		template<class _TFunc, class..._TArgs>
+		auto post_fixed_rate(const DurationT& period, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(function(args...)), TimerIdT{});
+		template<class _TFunc, class..._TArgs>
+		auto post_fixed_rate(const DurationT& period, _TFunc&& function, _TArgs&&... args) noexcept
+			-> decltype(void(function(args...)), TimerIdT{});
+		bool cancel_timer(TimerIdT id) noexcept;
+		size_t get_timers_num() noexcept;
+
+#ifdef _HICXX_COROUTINE
+		ScheduleAwaiterT schedule(PriorityT priority = 0) noexcept;
+#endif
+
+		template<class _TIter>
+		auto submit_bulk_unchecked(PriorityT priority, _TIter first, _TIter last) noexcept
+			-> ::std::vector<FutureT<decltype((*first)())>>;
+		template<class _TGenerator>
+		auto submit_bulk_unchecked(PriorityT priority, size_t num, _TGenerator&& generator) noexcept
+			-> ::std::vector<FutureT<decltype(generator(size_t{})())>>;
+		template<class _TIter>
+		auto execute_bulk_unchecked(PriorityT priority, _TIter first, _TIter last) noexcept
+			-> decltype(void((*first)()));
+		template<class _TGenerator>
+		auto execute_bulk_unchecked(PriorityT priority, size_t num, _TGenerator&& generator) noexcept
+			-> decltype(void(generator(size_t{})()));
+
+		template<class _TIter>
+		auto submit_bulk(PriorityT priority, _TIter first, _TIter last) noexcept
+			-> ::std::vector<FutureT<decltype((*first)())>>;
+		template<class _TGenerator>
+		auto submit_bulk(PriorityT priority, size_t num, _TGenerator&& generator) noexcept
+			-> ::std::vector<FutureT<decltype(generator(size_t{})())>>;
+		template<class _TIter>
+		auto submit_bulk(_TIter first, _TIter last) noexcept
+			-> ::std::vector<FutureT<decltype((*first)())>>;
+		template<class _TGenerator>
+		auto submit_bulk(size_t num, _TGenerator&& generator) noexcept
+			-> ::std::vector<FutureT<decltype(generator(size_t{})())>>;
+		template<class _TIter>
+		auto execute_bulk(PriorityT priority, _TIter first, _TIter last) noexcept
+			-> decltype(void((*first)()));
+		template<class _TGenerator>
+		auto execute_bulk(PriorityT priority, size_t num, _TGenerator&& generator) noexcept
+			-> decltype(void(generator(size_t{})()));
+		template<class _TIter>
+		auto execute_bulk(_TIter first, _TIter last) noexcept
+			-> decltype(void((*first)()));
+		template<class _TGenerator>
+		auto execute_bulk(size_t num, _TGenerator&& generator) noexcept
+			-> decltype(void(generator(size_t{})()));
+
+		template<class _TFunc, class..._TArgs>
+		auto package_task(TaskT& task, _TFunc&& function, _TArgs&&... args) noexcept
+			-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>;
+		template<class _TFunc, class..._TArgs>
+		void package_post(TaskT& task, _TFunc&& function, _TArgs&&... args) noexcept;
+		template<class _TFunc, class..._TArgs>
+		static SharedFunctionT package_periodic(_TFunc&& function, _TArgs&&... args) noexcept;
+		void report_exception(const char* what) noexcept;
+		UniqueLockT lock_tasks() noexcept;
+		void stamp_task(TaskT& task) noexcept;
+		void stamp_tasks(TaskVectorT& tasks) noexcept;
+#ifdef _HICXX_METRICS
+		MetricsT& get_metrics() noexcept;
+#endif
+		CountersT& get_counters() noexcept;
+		CounterT get_done_num() const noexcept;
+		static void set_label(TaskT& task, const char* label) noexcept;
+		CancelTokenT package_cancellable(TaskT& task, const CancelGroupT* group) noexcept;
+		static bool cancel_task(CancelStateT& state) noexcept;
+		bool claim_task(TaskT& task) noexcept;
+		void drop_task(TaskT& task) noexcept;
+		static CancelStateT*& get_current_cancel() noexcept;
+#ifdef _HICXX_COROUTINE
+		static HandleVectorT& get_dropped_handles() noexcept;
+#endif
+		static void resume_dropped() noexcept;
+#ifdef _HICXX_TRACE
+		void record_trace(const TaskT& task, const TimePointT& begin_time, const TimePointT& end_time) noexcept;
+		static void write_trace_label(::std::string& text, const char* label) noexcept;
+#endif
+		bool is_local_task(const TaskT& task) const noexcept;
+		QueueT* get_queue(QueueIdT id) const noexcept;
+		QueueT& ensure_default_queue_unchecked() noexcept;
+		bool is_fair() const noexcept;
+		TaskQueueT& get_task_queue(const QueueT* queue) noexcept;
+		void enqueue_shared_unchecked(TaskT&& task) noexcept;
+		bool is_queue_ready(const QueueT& queue) noexcept;
+		bool has_shared_task_unchecked() noexcept;
+		bool pop_fair_task_unchecked(TaskT& task) noexcept;
+		void finish_queue_task(const TaskT& task, const TimePointT& begin_time, const TimePointT& end_time) noexcept;
+		void push_task_unchecked(TaskT&& task) noexcept;
+		bool push_task(TaskT&& task, const TimePointT& wait_time = TimePointT::max()) noexcept;
+		bool is_full_unchecked() const noexcept;
+		bool admit_task(TaskT& task, const TimePointT& wait_time) noexcept;
+		bool evict_task_unchecked(const TaskT& task, bool oldest) noexcept;
+		void reject_task(TaskT& task) noexcept;
+		void notify_space() noexcept;
+		void push_shared_task_unchecked(TaskT&& task) noexcept;
+		void push_shared_task(TaskT&& task) noexcept;
+		void push_tasks_unchecked(TaskVectorT& tasks) noexcept;
+		void push_tasks(TaskVectorT& tasks) noexcept;
+		void push_shared_tasks_unchecked(TaskVectorT& tasks) noexcept;
+		bool push_local_tasks(TaskVectorT& tasks) noexcept;
+		void notify_workers(TaskNumT num) noexcept;
+		void push_local_task(TaskT&& task) noexcept;
+		bool pop_shared_task_unchecked(TaskT& task, bool urgent_only) noexcept;
+		bool pop_shared_task(TaskT& task, bool urgent_only) noexcept;
+		bool pop_local_task(TaskT& task, ThreadPtrT ptr) noexcept;
+		bool steal_task(TaskT& task, ThreadPtrT ptr) noexcept;
+		bool steal_task(TaskT& task, ThreadPtrT ptr, bool same_node) noexcept;
+		bool is_numa_aware() const noexcept;
+		void flush_local_tasks(ThreadPtrT ptr) noexcept;
+		void retire_worker(ThreadPtrT ptr) noexcept;
+		void join_workers() noexcept;
+		ThreadPtrT revive_worker() noexcept;
+		void notify_idle() noexcept;
+		void notify_done() noexcept;
+		void notify_discarded_unchecked() noexcept;
+		void notify_discarded() noexcept;
+		void notify_state() noexcept;
+		void wait_running_done() noexcept;
+		void wait_threads_deleted() noexcept;
+		static ThreadPtrT& get_current_worker() noexcept;
+
+		static bool is_expired(const TaskT& task, const TimePointT& now) noexcept;
+		TimerIdT insert_timer_unchecked(const TimePointT& time, const DurationT& period, TimerT&& timer) noexcept;
+		TimerIdT insert_timer(const TimePointT& time, const DurationT& period, TimerT&& timer) noexcept;
+		void rearm_timer(TimerIdT id, const DurationT& period) noexcept;
+		void schedule_purge(const TimePointT& expiration_time) noexcept;
+		void purge_expired() noexcept;
+		TimerActionT fire_timer(TimerIdT id, TimerT& timer, TaskVectorT& tasks, bool& purge, bool& scale) noexcept;
+		void arm_autoscale() noexcept;
+		void autoscale() noexcept;
+		void timer_mission() noexcept;
+		void stop_timer() noexcept;
 
+		bool has_work() const noexcept;
+		bool spin_for_task() const noexcept;
 		bool get_task(TaskT& task) noexcept;
+		bool get_task(TaskT& task, ThreadPtrT ptr) noexcept;
+		void run_task(TaskT& task) noexcept;
+		bool run_one() noexcept;
+		bool is_hungry() const noexcept;
 		void mission(ThreadPtrT ptr) noexcept;
 
 		MutexManagerT m_mutex_manager;
 		DatasManagerT m_datas_manager;
-		StateManagerT m_state_manager;
+		alignas(cache_line_size) StateManagerT m_state_manager;
 	};
 
 	template<int UserLevel = 1> class thread_pool : public thread_pool_public
@@ -207,6 +1085,17 @@ namespace HiCxx
 		using BasicThreadPoolT::set_threads_num_unchecked;
 		using BasicThreadPoolT::set_multi_unchecked;
 		using BasicThreadPoolT::set_try_mode_unchecked;
+		using BasicThreadPoolT::set_stealing_unchecked;
+		using BasicThreadPoolT::set_local_submit_unchecked;
+		using BasicThreadPoolT::set_edf_unchecked;
+		using BasicThreadPoolT::set_aging_unchecked;
+		using BasicThreadPoolT::set_idle_policy_unchecked;
+		using BasicThreadPoolT::set_placement_unchecked;
+		using BasicThreadPoolT::set_autoscale_unchecked;
+		using BasicThreadPoolT::set_bound_unchecked;
+#ifdef _HICXX_TRACE
+		using BasicThreadPoolT::set_tracing_unchecked;
+#endif
 		using BasicThreadPoolT::resume;
 		using BasicThreadPoolT::pause_no_wait;
 		using BasicThreadPoolT::pause;
@@ -217,6 +1106,17 @@ namespace HiCxx
 		using BasicThreadPoolT::set_threads_num;
 		using BasicThreadPoolT::set_multi;
 		using BasicThreadPoolT::set_try_mode;
+		using BasicThreadPoolT::set_stealing;
+		using BasicThreadPoolT::set_local_submit;
+		using BasicThreadPoolT::set_edf;
+		using BasicThreadPoolT::set_aging;
+		using BasicThreadPoolT::set_idle_policy;
+		using BasicThreadPoolT::set_placement;
+		using BasicThreadPoolT::set_autoscale;
+		using BasicThreadPoolT::set_bound;
+#ifdef _HICXX_TRACE
+		using BasicThreadPoolT::set_tracing;
+#endif
 
 		using BasicThreadPoolT::get_mutex_manager_unchecked;
 		using BasicThreadPoolT::get_datas_manager_unchecked;
@@ -227,16 +1127,62 @@ namespace HiCxx
 		using BasicThreadPoolT::wait_until_all_done_unchecked;
 		using BasicThreadPoolT::wait_for_all_done_unchecked;
 		using BasicThreadPoolT::submit_unchecked;
+		using BasicThreadPoolT::post_unchecked;
+		using BasicThreadPoolT::submit_bulk_unchecked;
+		using BasicThreadPoolT::execute_bulk_unchecked;
 		using BasicThreadPoolT::get_mutex_manager;
 		using BasicThreadPoolT::get_datas_manager;
 		using BasicThreadPoolT::get_state_manager;
 		using BasicThreadPoolT::get_tasks_num;
 		using BasicThreadPoolT::is_all_done;
+		using BasicThreadPoolT::get_deadline_stats;
+		using BasicThreadPoolT::reset_deadline_stats;
+		using BasicThreadPoolT::get_overflow_stats;
+		using BasicThreadPoolT::reset_overflow_stats;
+#ifdef _HICXX_METRICS
+		using BasicThreadPoolT::get_metrics_snapshot;
+		using BasicThreadPoolT::reset_metrics;
+#endif
+#ifdef _HICXX_TRACE
+		using BasicThreadPoolT::dump_trace;
+		using BasicThreadPoolT::clear_trace;
+#endif
 		using BasicThreadPoolT::wait_all_done;
 		using BasicThreadPoolT::wait_until_all_done;
 		using BasicThreadPoolT::wait_for_all_done;
 		using BasicThreadPoolT::submit;
+		using BasicThreadPoolT::post;
 		using BasicThreadPoolT::execute;
+		using BasicThreadPoolT::post_local;
+		using BasicThreadPoolT::submit_traced;
+		using BasicThreadPoolT::post_traced;
+		using BasicThreadPoolT::submit_cancellable;
+		using BasicThreadPoolT::post_cancellable;
+		using BasicThreadPoolT::make_cancel_group;
+		using BasicThreadPoolT::is_cancel_requested;
+		using BasicThreadPoolT::try_submit;
+		using BasicThreadPoolT::submit_for;
+		using BasicThreadPoolT::try_post;
+		using BasicThreadPoolT::post_for;
+		using BasicThreadPoolT::create_queue;
+		using BasicThreadPoolT::set_queue;
+		using BasicThreadPoolT::find_queue;
+		using BasicThreadPoolT::get_queue_stats;
+		using BasicThreadPoolT::submit_to;
+		using BasicThreadPoolT::post_to;
+		using BasicThreadPoolT::submit_at;
+		using BasicThreadPoolT::submit_after;
+		using BasicThreadPoolT::post_at;
+		using BasicThreadPoolT::post_after;
+		using BasicThreadPoolT::post_periodic;
+		using BasicThreadPoolT::post_fixed_rate;
+		using BasicThreadPoolT::cancel_timer;
+		using BasicThreadPoolT::get_timers_num;
+#ifdef _HICXX_COROUTINE
+		using BasicThreadPoolT::schedule;
+#endif
+		using BasicThreadPoolT::submit_bulk;
+		using BasicThreadPoolT::execute_bulk;
 		using BasicThreadPoolT::m_mutex_manager;
 		using BasicThreadPoolT::m_datas_manager;
 		using BasicThreadPoolT::m_state_manager;
@@ -259,6 +1205,17 @@ namespace HiCxx
 		using BasicThreadPoolT::set_threads_num_unchecked;
 		using BasicThreadPoolT::set_multi_unchecked;
 		using BasicThreadPoolT::set_try_mode_unchecked;
+		using BasicThreadPoolT::set_stealing_unchecked;
+		using BasicThreadPoolT::set_local_submit_unchecked;
+		using BasicThreadPoolT::set_edf_unchecked;
+		using BasicThreadPoolT::set_aging_unchecked;
+		using BasicThreadPoolT::set_idle_policy_unchecked;
+		using BasicThreadPoolT::set_placement_unchecked;
+		using BasicThreadPoolT::set_autoscale_unchecked;
+		using BasicThreadPoolT::set_bound_unchecked;
+#ifdef _HICXX_TRACE
+		using BasicThreadPoolT::set_tracing_unchecked;
+#endif
 
 		using BasicThreadPoolT::get_mutex_manager_unchecked;
 		using BasicThreadPoolT::get_datas_manager_unchecked;
@@ -269,6 +1226,9 @@ namespace HiCxx
 		using BasicThreadPoolT::wait_until_all_done_unchecked;
 		using BasicThreadPoolT::wait_for_all_done_unchecked;
 		using BasicThreadPoolT::submit_unchecked;
+		using BasicThreadPoolT::post_unchecked;
+		using BasicThreadPoolT::submit_bulk_unchecked;
+		using BasicThreadPoolT::execute_bulk_unchecked;
 		using BasicThreadPoolT::m_mutex_manager;
 		using BasicThreadPoolT::m_datas_manager;
 		using BasicThreadPoolT::m_state_manager;
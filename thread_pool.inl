@@ -8,6 +8,11 @@
 
 namespace HiCxx
 {
+	inline bool thread_pool_public::TaskT::has_deadline() const noexcept
+	{
+		return this->m_expiration_time != TimePointT{} && this->m_expiration_time != TimePointT::max();
+	}
+
 	constexpr bool thread_pool_public::TaskT::operator<(const TaskT& task) const noexcept
 	{
 		return this->m_priority < task.m_priority;
@@ -18,6 +23,413 @@ namespace HiCxx
 		return this->m_priority > task.m_priority;
 	}
 
+	inline bool thread_pool_public::TaskRingT::empty() const noexcept
+	{
+		return this->m_size == 0;
+	}
+
+	inline size_t thread_pool_public::TaskRingT::size() const noexcept
+	{
+		return this->m_size;
+	}
+
+	inline thread_pool_public::TaskT& thread_pool_public::TaskRingT::front() noexcept
+	{
+		return this->m_tasks[this->m_head];
+	}
+
+	inline const thread_pool_public::TaskT& thread_pool_public::TaskRingT::front() const noexcept
+	{
+		return this->m_tasks[this->m_head];
+	}
+
+	inline const thread_pool_public::TaskT& thread_pool_public::TaskRingT::back() const noexcept
+	{
+		return this->m_tasks[(this->m_head + this->m_size - 1) & (this->m_tasks.size() - 1)];
+	}
+
+	inline void thread_pool_public::TaskRingT::push(TaskT&& task) noexcept
+	{
+		const size_t capacity = this->m_tasks.size();
+		if (this->m_size == capacity)
+		{
+			TaskVectorT tasks(capacity ? capacity * 2 : 16);
+			for (size_t i = 0; i < this->m_size; ++i)
+				tasks[i] = ::std::move(this->m_tasks[(this->m_head + i) & (capacity - 1)]);
+			this->m_tasks.swap(tasks);
+			this->m_head = 0;
+		}
+		this->m_tasks[(this->m_head + this->m_size) & (this->m_tasks.size() - 1)] = ::std::move(task);
+		++this->m_size;
+	}
+
+	inline void thread_pool_public::TaskRingT::pop(TaskT& task) noexcept
+	{
+		task = ::std::move(this->m_tasks[this->m_head]);
+		this->m_head = (this->m_head + 1) & (this->m_tasks.size() - 1);
+		--this->m_size;
+	}
+
+	inline void thread_pool_public::TaskRingT::pop_back(TaskT& task) noexcept
+	{
+		--this->m_size;
+		task = ::std::move(this->m_tasks[(this->m_head + this->m_size) & (this->m_tasks.size() - 1)]);
+	}
+
+	inline void thread_pool_public::TaskRingT::clear() noexcept
+	{
+		TaskVectorT{}.swap(this->m_tasks);
+		this->m_head = 0;
+		this->m_size = 0;
+	}
+
+	inline size_t thread_pool_public::TaskRingT::purge(const TimePointT& now, TimePointT& earliest) noexcept
+	{
+		const size_t mask = this->m_tasks.size() - 1;
+		size_t kept = 0;
+		for (size_t i = 0; i < this->m_size; ++i)
+		{
+			TaskT& task = this->m_tasks[(this->m_head + i) & mask];
+			if (is_expired(task, now))
+			{
+				task.m_function.reset();
+				continue;
+			}
+			if (!task.m_submit_on_expiration && task.m_expiration_time < earliest)
+				earliest = task.m_expiration_time;
+			if (kept != i)
+				this->m_tasks[(this->m_head + kept) & mask] = ::std::move(task);
+			++kept;
+		}
+		const size_t removed = this->m_size - kept;
+		this->m_size = kept;
+		return removed;
+	}
+
+	inline size_t thread_pool_public::TaskQueueT::get_level(PriorityT priority) noexcept
+	{
+		if (priority < priority_min)
+			return 0;
+		if (priority > priority_max)
+			return levels_num - 1;
+		return (size_t)(priority - priority_min);
+	}
+
+	inline size_t thread_pool_public::TaskQueueT::get_highest_level(LevelBitmapT bitmap) noexcept
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanReverse64(&index, bitmap);
+		return (size_t)index;
+#elif defined(__GNUC__)
+		return (size_t)(63 - __builtin_clzll(bitmap));
+#else
+		size_t index = 0;
+		while (bitmap >>= 1)
+			++index;
+		return index;
+#endif
+	}
+
+	inline bool thread_pool_public::TaskQueueT::is_later(const TaskT& task1, const TaskT& task2) noexcept
+	{
+		if (task1.m_expiration_time != task2.m_expiration_time)
+			return task1.m_expiration_time > task2.m_expiration_time;
+		return task1.m_priority < task2.m_priority;
+	}
+
+	inline void thread_pool_public::TaskQueueT::set_edf(bool edf) noexcept
+	{
+		if (this->m_edf == edf)
+			return;
+
+		TaskVectorT tasks;
+		tasks.reserve(this->m_size);
+		while (!this->empty())
+		{
+			tasks.emplace_back();
+			this->pop(tasks.back());
+		}
+		this->m_edf = edf;
+		for (TaskT& task : tasks)
+			this->insert(::std::move(task));
+	}
+
+	inline void thread_pool_public::TaskQueueT::set_aging(const AgingT& aging) noexcept
+	{
+		const DurationT interval = ::std::max(aging.m_interval, DurationT::zero());
+		this->m_aging_interval = interval;
+		this->m_max_age = 0;
+		if (interval > DurationT::zero() && aging.m_max_wait > DurationT::zero())
+			this->m_max_age = (::uint32_t)::std::max<::int64_t>((aging.m_max_wait + interval - DurationT(1)) / interval, 1);
+		this->m_epoch_time = ClockT::now();
+	}
+
+	inline void thread_pool_public::TaskQueueT::update_epoch() noexcept
+	{
+		const TimePointT now = ClockT::now();
+		if (now - this->m_epoch_time < this->m_aging_interval)
+			return;
+
+		const auto epochs = (now - this->m_epoch_time) / this->m_aging_interval;
+		this->m_epoch += (::uint32_t)epochs;
+		this->m_epoch_time += epochs * this->m_aging_interval;
+	}
+
+	inline size_t thread_pool_public::TaskQueueT::get_top_level() const noexcept
+	{
+		const size_t highest = get_highest_level(this->m_bitmap);
+		if (this->m_aging_interval == DurationT::zero() || (this->m_bitmap & (this->m_bitmap - 1)) == 0)
+			return highest;
+
+		constexpr ::int64_t overdue = (::int64_t)1 << 40;
+		size_t top_level = highest;
+		::int64_t top_key = -1;
+		for (LevelBitmapT bitmap = this->m_bitmap; bitmap; bitmap &= ~((LevelBitmapT)1 << get_highest_level(bitmap)))
+		{
+			const size_t level = get_highest_level(bitmap);
+			const ::uint32_t age = this->m_epoch - this->m_levels[level].front().m_epoch;
+			const ::int64_t key = (this->m_max_age != 0 && age >= this->m_max_age) ? overdue + age : (::int64_t)level + age;
+			if (key > top_key)
+			{
+				top_level = level;
+				top_key = key;
+			}
+		}
+		return top_level;
+	}
+
+	inline size_t thread_pool_public::TaskQueueT::get_lowest_level() const noexcept
+	{
+		return get_highest_level(this->m_bitmap & (~this->m_bitmap + 1));
+	}
+
+	inline size_t thread_pool_public::TaskQueueT::get_oldest_level() const noexcept
+	{
+		size_t oldest_level = get_highest_level(this->m_bitmap);
+		for (LevelBitmapT bitmap = this->m_bitmap & ~((LevelBitmapT)1 << oldest_level); bitmap; bitmap &= bitmap - 1)
+		{
+			const size_t level = get_highest_level(bitmap & (~bitmap + 1));
+			if ((::int32_t)(this->m_levels[level].front().m_sequence - this->m_levels[oldest_level].front().m_sequence) < 0)
+				oldest_level = level;
+		}
+		return oldest_level;
+	}
+
+	inline bool thread_pool_public::TaskQueueT::empty() const noexcept
+	{
+		return this->m_size == 0;
+	}
+
+	inline size_t thread_pool_public::TaskQueueT::size() const noexcept
+	{
+		return this->m_size;
+	}
+
+	inline const thread_pool_public::TaskT& thread_pool_public::TaskQueueT::top() const noexcept
+	{
+		if (!this->m_deadlines.empty())
+			return this->m_deadlines.front();
+		return this->m_levels[this->get_top_level()].front();
+	}
+
+	inline void thread_pool_public::TaskQueueT::push(TaskT&& task) noexcept
+	{
+		if (this->m_aging_interval > DurationT::zero())
+		{
+			this->update_epoch();
+			task.m_epoch = this->m_epoch;
+		}
+		this->insert(::std::move(task));
+	}
+
+	inline void thread_pool_public::TaskQueueT::insert(TaskT&& task) noexcept
+	{
+		if (this->m_edf && task.has_deadline())
+		{
+			this->m_deadlines.push_back(::std::move(task));
+			::std::push_heap(this->m_deadlines.begin(), this->m_deadlines.end(), &TaskQueueT::is_later);
+			++this->m_size;
+			return;
+		}
+
+		const size_t level = get_level(task.m_priority);
+		this->m_levels[level].push(::std::move(task));
+		this->m_bitmap |= (LevelBitmapT)1 << level;
+		++this->m_size;
+	}
+
+	inline void thread_pool_public::TaskQueueT::pop(TaskT& task) noexcept
+	{
+		if (!this->m_deadlines.empty())
+		{
+			::std::pop_heap(this->m_deadlines.begin(), this->m_deadlines.end(), &TaskQueueT::is_later);
+			task = ::std::move(this->m_deadlines.back());
+			this->m_deadlines.pop_back();
+			--this->m_size;
+			return;
+		}
+
+		if (this->m_aging_interval > DurationT::zero())
+			this->update_epoch();
+		const size_t level = this->get_top_level();
+		TaskRingT& ring = this->m_levels[level];
+		ring.pop(task);
+		if (ring.empty())
+			this->m_bitmap &= ~((LevelBitmapT)1 << level);
+		--this->m_size;
+	}
+
+	inline void thread_pool_public::TaskQueueT::evict(size_t level, bool oldest, TaskT& task) noexcept
+	{
+		TaskRingT& ring = this->m_levels[level];
+		if (oldest)
+			ring.pop(task);
+		else
+			ring.pop_back(task);
+		if (ring.empty())
+			this->m_bitmap &= ~((LevelBitmapT)1 << level);
+		--this->m_size;
+	}
+
+	inline void thread_pool_public::TaskQueueT::clear() noexcept
+	{
+		for (TaskRingT& ring : this->m_levels)
+			ring.clear();
+		TaskVectorT{}.swap(this->m_deadlines);
+		this->m_bitmap = 0;
+		this->m_size = 0;
+	}
+
+	inline bool thread_pool_public::CancelTokenT::valid() const noexcept
+	{
+		return this->m_state != nullptr;
+	}
+
+	inline thread_pool_public::CancelStatusT thread_pool_public::CancelTokenT::get_status() const noexcept
+	{
+		return this->m_state->m_status.load();
+	}
+
+	inline bool thread_pool_public::CancelTokenT::cancel() const noexcept
+	{
+		return this->m_state && cancel_task(*this->m_state);
+	}
+
+	inline bool thread_pool_public::CancelGroupT::valid() const noexcept
+	{
+		return this->m_state != nullptr;
+	}
+
+	inline void thread_pool_public::CancelGroupT::add(const CancelStatePtrT& state) const noexcept
+	{
+		LockGuardT lock(this->m_state->m_mutex);
+		::std::vector<CancelStatePtrT>& states = this->m_state->m_states;
+		if (states.size() >= this->m_state->m_prune_size)
+		{
+			states.erase(::std::remove_if(states.begin(), states.end(), [](const CancelStatePtrT& state)
+				{
+					const CancelStatusT status = state->m_status.load();
+					return status == CancelStatusT::cancelled || status == CancelStatusT::finished;
+				}), states.end());
+			this->m_state->m_prune_size = ::std::max(states.size() * 2, (size_t)16);
+		}
+		states.push_back(state);
+	}
+
+	inline size_t thread_pool_public::CancelGroupT::cancel() const noexcept
+	{
+		::std::vector<CancelStatePtrT> states;
+		{
+			LockGuardT lock(this->m_state->m_mutex);
+			states.swap(this->m_state->m_states);
+			this->m_state->m_prune_size = 16;
+		}
+		size_t num = 0;
+		for (const CancelStatePtrT& state : states)
+			num += cancel_task(*state) ? 1 : 0;
+		return num;
+	}
+
+	inline ::int64_t thread_pool_public::QueueT::get_quantum() const noexcept
+	{
+		return (::int64_t)::std::chrono::duration_cast<::std::chrono::nanoseconds>(quantum).count() * (::int64_t)this->m_weight;
+	}
+
+	inline bool thread_pool_public::QueueT::is_saturated() const noexcept
+	{
+		const ThreadNumT max_running = this->m_max_running;
+		return max_running > 0 && this->m_running_num >= max_running;
+	}
+
+#ifdef _HICXX_COROUTINE
+	inline bool thread_pool_public::ScheduleAwaiterT::await_ready() const noexcept
+	{
+		return false;
+	}
+
+	inline bool thread_pool_public::ScheduleAwaiterT::await_suspend(::std::coroutine_handle<> handle) noexcept
+	{
+		if (this->m_pool.m_state_manager.m_stopped)
+			return false;
+		if (this->m_pool.try_post(this->m_priority, ResumeTaskT{ handle }))
+			return true;
+
+		get_dropped_handles().pop_back();
+		return false;
+	}
+
+	inline void thread_pool_public::ScheduleAwaiterT::await_resume() const noexcept
+	{
+	}
+
+	inline thread_pool_public::ResumeTaskT::ResumeTaskT(::std::coroutine_handle<> handle) noexcept
+		: m_handle(handle)
+	{
+	}
+
+	inline thread_pool_public::ResumeTaskT::ResumeTaskT(ResumeTaskT&& task) noexcept
+		: m_handle(::std::exchange(task.m_handle, nullptr))
+	{
+	}
+
+	inline thread_pool_public::ResumeTaskT::~ResumeTaskT() noexcept
+	{
+		if (this->m_handle)
+			get_dropped_handles().push_back(this->m_handle);
+	}
+
+	inline void thread_pool_public::ResumeTaskT::operator()() noexcept
+	{
+		::std::exchange(this->m_handle, nullptr).resume();
+	}
+
+#endif
+	inline size_t thread_pool_public::TaskQueueT::purge(const TimePointT& now, TimePointT& earliest) noexcept
+	{
+		const size_t deadlines_num = this->m_deadlines.size();
+		this->m_deadlines.erase(::std::remove_if(this->m_deadlines.begin(), this->m_deadlines.end(),
+			[&now](const TaskT& task) { return is_expired(task, now); }), this->m_deadlines.end());
+		::std::make_heap(this->m_deadlines.begin(), this->m_deadlines.end(), &TaskQueueT::is_later);
+		for (const TaskT& task : this->m_deadlines)
+		{
+			if (!task.m_submit_on_expiration && task.m_expiration_time < earliest)
+				earliest = task.m_expiration_time;
+		}
+
+		size_t removed = deadlines_num - this->m_deadlines.size();
+		for (LevelBitmapT bitmap = this->m_bitmap; bitmap; bitmap &= bitmap - 1)
+		{
+			const size_t level = get_highest_level(bitmap & (~bitmap + 1));
+			TaskRingT& ring = this->m_levels[level];
+			removed += ring.purge(now, earliest);
+			if (ring.empty())
+				this->m_bitmap &= ~((LevelBitmapT)1 << level);
+		}
+		this->m_size -= removed;
+		return removed;
+	}
+
 	inline thread_pool_public::thread_pool_public(ThreadNumT threads_num) noexcept
 	{
 		this->start_unchecked(threads_num);
@@ -25,7 +437,17 @@ namespace HiCxx
 
 	inline thread_pool_public::~thread_pool_public() noexcept
 	{
+		this->stop_timer();
 		this->stop();
+		ThreadPtrT ptr = this->m_datas_manager.m_workers.exchange(nullptr);
+		while (ptr)
+		{
+			ThreadPtrT next = ptr->m_next;
+			if (ptr->m_thread.joinable())
+				ptr->m_thread.join();
+			delete ptr;
+			ptr = next;
+		}
 	}
 
 	inline void thread_pool_public::resume_unchecked() noexcept
@@ -43,10 +465,7 @@ namespace HiCxx
 	inline void thread_pool_public::pause_unchecked() noexcept
 	{
 		this->pause_no_wait_unchecked();
-		while (this->m_datas_manager.m_running_num)
-		{
-			std::this_thread::yield();
-		}
+		this->wait_running_done();
 	}
 
 	inline void thread_pool_public::start_unchecked(ThreadNumT threads_num) noexcept
@@ -54,6 +473,7 @@ namespace HiCxx
 		this->m_state_manager.m_stopped = false;
 		this->resume_unchecked();
 		this->set_threads_num_no_wait_unchecked(threads_num);
+		this->arm_autoscale();
 	}
 
 	inline void thread_pool_public::stop_no_wait_unchecked() noexcept
@@ -62,7 +482,11 @@ namespace HiCxx
 		this->m_mutex_manager.m_task_condition.notify_all();
 		this->m_mutex_manager.m_pause_condition.notify_all();
 		this->m_mutex_manager.m_wait_condition.notify_all();
+		this->m_mutex_manager.m_space_condition.notify_all();
+		this->notify_state();
 		this->clear_unchecked();
+		if (!this->m_state_manager.m_multi)
+			this->resume_dropped();
 	}
 
 	inline void thread_pool_public::stop_unchecked() noexcept
@@ -71,26 +495,59 @@ namespace HiCxx
 		this->m_mutex_manager.m_task_condition.notify_all();
 		this->m_mutex_manager.m_pause_condition.notify_all();
 		this->m_mutex_manager.m_wait_condition.notify_all();
-		while (this->m_datas_manager.m_running_num)
-		{
-			std::this_thread::yield();
-		}
+		this->m_mutex_manager.m_space_condition.notify_all();
+		this->notify_state();
+		this->wait_running_done();
 		this->clear_unchecked();
+		if (!this->m_state_manager.m_multi)
+			this->resume_dropped();
 	}
 
 	inline void thread_pool_public::clear_unchecked() noexcept
 	{
 		this->m_datas_manager.m_threads.clear();
+		for (TaskT task; !this->m_datas_manager.m_tasks.empty(); )
+		{
+			this->m_datas_manager.m_tasks.pop(task);
+			this->drop_task(task);
+		}
 		this->m_datas_manager.m_tasks.clear();
+		for (size_t i = 1; i < this->m_datas_manager.m_queues_num; ++i)
+		{
+			TaskQueueT& tasks = this->m_datas_manager.m_queues[i]->m_tasks;
+			for (TaskT task; !tasks.empty(); )
+			{
+				tasks.pop(task);
+				this->drop_task(task);
+			}
+			tasks.clear();
+		}
+		this->m_datas_manager.m_shared_num = 0;
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+		{
+			LockGuardT lock(ptr->m_local_mutex);
+			for (TaskT& task : ptr->m_local_tasks)
+				this->drop_task(task);
+			this->m_datas_manager.m_local_num -= (TaskNumT)ptr->m_local_tasks.size();
+			ptr->m_local_tasks.clear();
+			ptr->m_local_num = 0;
+		}
+		this->m_mutex_manager.m_space_condition.notify_all();
+		LockGuardT lock(this->m_mutex_manager.m_timer_mutex);
+		this->m_datas_manager.m_timers.clear();
+		this->m_datas_manager.m_autoscale_timer = TimerIdT{};
+		this->m_datas_manager.m_purge_timer = TimerIdT{};
+		this->m_datas_manager.m_purge_time.store(TimePointT::max());
 	}
 
 	inline void thread_pool_public::set_threads_num_no_wait_unchecked(ThreadNumT threads_num) noexcept
 	{
+		this->join_workers();
 		if (threads_num < this->m_datas_manager.m_threads_num)
 		{
 			const ThreadNumT delta = this->m_datas_manager.m_threads_num - threads_num;
 			this->m_datas_manager.m_threads_num = threads_num;
-			this->m_datas_manager.m_delete_num = delta;
+			this->m_datas_manager.m_delete_num += delta;
 			this->m_mutex_manager.m_task_condition.notify_all();
 			this->m_mutex_manager.m_pause_condition.notify_all();
 		}
@@ -98,11 +555,44 @@ namespace HiCxx
 		{
 			ThreadNumT i = this->m_datas_manager.m_threads_num;
 			this->m_datas_manager.m_threads_num = threads_num;
+			ThreadNumT delete_num = this->m_datas_manager.m_delete_num;
+			while (delete_num > 0 && !this->m_datas_manager.m_delete_num.compare_exchange_weak(delete_num, delete_num - ::std::min(delete_num, threads_num - i)));
+			if (delete_num > 0)
+			{
+				i += ::std::min(delete_num, threads_num - i);
+				this->notify_state();
+			}
 			for (; i < threads_num; ++i)
 			{
-				ThreadPtrT ptr = new ThreadPackT{};
-				ptr->m_thread = ThreadT{ &thread_pool_public::mission, this, ptr };
+				ThreadPtrT ptr = this->revive_worker();
+				const bool revived = ptr != nullptr;
+				if (!revived)
+				{
+					ptr = new ThreadPackT{};
+					ptr->m_counters.m_exclusive = true;
+#ifdef _HICXX_METRICS
+					ptr->m_metrics.m_exclusive = true;
+#endif
+				}
+				ptr->m_pool = this;
 				ptr->m_enable = true;
+				if (this->m_state_manager.m_placement != PlacementT::none && !this->m_datas_manager.m_topology.empty())
+				{
+					ptr->m_cpu = this->m_datas_manager.m_topology.get_cpu((size_t)i, this->m_state_manager.m_placement == PlacementT::scatter);
+					ptr->m_node = this->m_datas_manager.m_topology.get_node_index(ptr->m_cpu);
+				}
+#ifdef _HICXX_TRACE
+				if (!revived)
+					ptr->m_index = this->m_datas_manager.m_spawned_num++;
+				if (this->m_state_manager.m_tracing)
+					ptr->m_trace.allocate(this->m_datas_manager.m_trace_capacity);
+#endif
+				if (!revived)
+				{
+					ptr->m_next = this->m_datas_manager.m_workers.load();
+					this->m_datas_manager.m_workers = ptr;
+				}
+				ptr->m_thread = ThreadT{ &thread_pool_public::mission, this, ptr };
 				this->m_datas_manager.m_threads[ptr->m_thread.get_id()] = ptr;
 			}
 		}
@@ -112,14 +602,13 @@ namespace HiCxx
 	{
 		bool wait = threads_num < this->m_datas_manager.m_threads_num;
 		this->set_threads_num_no_wait_unchecked(threads_num);
-		if(wait)
-			while (this->m_datas_manager.m_delete_num)
-				std::this_thread::yield();
+		if (wait)
+			this->wait_threads_deleted();
 	}
 
 	inline void thread_pool_public::set_multi_unchecked(bool multi) noexcept
 	{
-		this->m_state_manager.m_multi = multi;
+		this->m_state_manager.m_multi = multi || this->m_state_manager.m_autoscale.m_enable;
 	}
 
 	inline void thread_pool_public::set_try_mode_unchecked(bool try_mode) noexcept
@@ -127,6 +616,44 @@ namespace HiCxx
 		this->m_state_manager.m_try_mode = try_mode;
 	}
 
+	inline void thread_pool_public::set_stealing_unchecked(bool stealing) noexcept
+	{
+		this->m_state_manager.m_stealing = stealing;
+	}
+
+	inline void thread_pool_public::set_local_submit_unchecked(bool local_submit) noexcept
+	{
+		this->m_state_manager.m_local_submit = local_submit;
+	}
+
+	inline void thread_pool_public::set_edf_unchecked(bool edf) noexcept
+	{
+		this->m_state_manager.m_edf = edf;
+		this->m_datas_manager.m_tasks.set_edf(edf);
+		for (size_t i = 1; i < this->m_datas_manager.m_queues_num; ++i)
+			this->m_datas_manager.m_queues[i]->m_tasks.set_edf(edf);
+	}
+
+	inline void thread_pool_public::set_aging_unchecked(const AgingT& aging) noexcept
+	{
+		this->m_state_manager.m_aging = aging;
+		this->m_datas_manager.m_tasks.set_aging(aging);
+		for (size_t i = 1; i < this->m_datas_manager.m_queues_num; ++i)
+			this->m_datas_manager.m_queues[i]->m_tasks.set_aging(aging);
+	}
+
+	inline void thread_pool_public::set_idle_policy_unchecked(const IdlePolicyT& idle_policy) noexcept
+	{
+		this->m_state_manager.m_idle_policy = idle_policy;
+	}
+
+	inline void thread_pool_public::set_placement_unchecked(PlacementT placement) noexcept
+	{
+		if (placement != PlacementT::none && this->m_datas_manager.m_topology.empty())
+			this->m_datas_manager.m_topology.load();
+		this->m_state_manager.m_placement = placement;
+	}
+
 	inline bool thread_pool_public::resume() noexcept
 	{
 		if (this->m_state_manager.m_stopped || !this->m_state_manager.m_pausing)
@@ -168,8 +695,11 @@ namespace HiCxx
 
 		if (this->m_state_manager.m_multi)
 		{
-			LockGuardT lock(this->m_mutex_manager.m_mutex);
-			this->pause_unchecked();
+			{
+				LockGuardT lock(this->m_mutex_manager.m_mutex);
+				this->pause_no_wait_unchecked();
+			}
+			this->wait_running_done();
 		}
 		else
 		{
@@ -202,8 +732,11 @@ namespace HiCxx
 
 		if (this->m_state_manager.m_multi)
 		{
-			LockGuardT lock(this->m_mutex_manager.m_mutex);
-			this->stop_no_wait_unchecked();
+			{
+				LockGuardT lock(this->m_mutex_manager.m_mutex);
+				this->stop_no_wait_unchecked();
+			}
+			this->resume_dropped();
 		}
 		else
 		{
@@ -219,8 +752,20 @@ namespace HiCxx
 
 		if (this->m_state_manager.m_multi)
 		{
-			LockGuardT lock(this->m_mutex_manager.m_mutex);
-			this->stop_unchecked();
+			{
+				LockGuardT lock(this->m_mutex_manager.m_mutex);
+				this->m_state_manager.m_stopped = true;
+				this->m_mutex_manager.m_task_condition.notify_all();
+				this->m_mutex_manager.m_pause_condition.notify_all();
+				this->m_mutex_manager.m_wait_condition.notify_all();
+			}
+			this->notify_state();
+			this->wait_running_done();
+			{
+				LockGuardT lock(this->m_mutex_manager.m_mutex);
+				this->clear_unchecked();
+			}
+			this->resume_dropped();
 		}
 		else
 		{
@@ -253,8 +798,14 @@ namespace HiCxx
 		
 		if (this->m_state_manager.m_multi)
 		{
-			LockGuardT lock(this->m_mutex_manager.m_mutex);
-			this->set_threads_num_unchecked(threads_num);
+			bool wait;
+			{
+				LockGuardT lock(this->m_mutex_manager.m_mutex);
+				wait = threads_num < this->m_datas_manager.m_threads_num;
+				this->set_threads_num_no_wait_unchecked(threads_num);
+			}
+			if (wait)
+				this->wait_threads_deleted();
 		}
 		else
 		{
@@ -290,21 +841,173 @@ namespace HiCxx
 		}
 	}
 
-	inline thread_pool_public::MutexManagerT& thread_pool_public::get_mutex_manager_unchecked() noexcept
+	inline void thread_pool_public::set_stealing(bool stealing) noexcept
 	{
-		return this->m_mutex_manager;
+		if (this->m_state_manager.m_multi)
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->set_stealing_unchecked(stealing);
+		}
+		else
+		{
+			this->set_stealing_unchecked(stealing);
+		}
 	}
 
-	inline thread_pool_public::DatasManagerT& thread_pool_public::get_datas_manager_unchecked() noexcept
+	inline void thread_pool_public::set_local_submit(bool local_submit) noexcept
 	{
-		return this->m_datas_manager;
+		if (this->m_state_manager.m_multi)
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->set_local_submit_unchecked(local_submit);
+		}
+		else
+		{
+			this->set_local_submit_unchecked(local_submit);
+		}
 	}
 
-	inline thread_pool_public::StateManagerT& thread_pool_public::get_state_manager_unchecked() noexcept
+	inline void thread_pool_public::set_edf(bool edf) noexcept
 	{
-		return this->m_state_manager;
-	}
-
+		if (this->m_state_manager.m_multi)
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->set_edf_unchecked(edf);
+		}
+		else
+		{
+			this->set_edf_unchecked(edf);
+		}
+	}
+
+	inline void thread_pool_public::set_aging(const AgingT& aging) noexcept
+	{
+		if (this->m_state_manager.m_multi)
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->set_aging_unchecked(aging);
+		}
+		else
+		{
+			this->set_aging_unchecked(aging);
+		}
+	}
+
+	inline void thread_pool_public::set_idle_policy(const IdlePolicyT& idle_policy) noexcept
+	{
+		if (this->m_state_manager.m_multi)
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->set_idle_policy_unchecked(idle_policy);
+		}
+		else
+		{
+			this->set_idle_policy_unchecked(idle_policy);
+		}
+	}
+
+	inline void thread_pool_public::set_autoscale_unchecked(const AutoscaleT& autoscale) noexcept
+	{
+		if (this->m_datas_manager.m_autoscale_timer.valid())
+			this->cancel_timer(this->m_datas_manager.m_autoscale_timer);
+		this->m_datas_manager.m_autoscale_timer = TimerIdT{};
+		this->m_state_manager.m_autoscale = autoscale;
+		this->m_state_manager.m_autoscale.m_max_num = ::std::max(autoscale.m_min_num, autoscale.m_max_num);
+		if (autoscale.m_enable)
+			this->m_state_manager.m_multi = true;
+		if (!this->m_state_manager.m_stopped)
+			this->arm_autoscale();
+	}
+
+	inline void thread_pool_public::set_bound_unchecked(const BoundT& bound) noexcept
+	{
+		this->m_state_manager.m_bound = bound;
+		this->m_mutex_manager.m_space_condition.notify_all();
+	}
+
+#ifdef _HICXX_TRACE
+	inline void thread_pool_public::set_tracing_unchecked(bool tracing, size_t capacity) noexcept
+	{
+		if (tracing)
+		{
+			if (this->m_datas_manager.m_trace_capacity == 0)
+				this->m_datas_manager.m_trace_capacity = capacity;
+			for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+				ptr->m_trace.allocate(this->m_datas_manager.m_trace_capacity);
+		}
+		this->m_state_manager.m_tracing = tracing;
+	}
+
+#endif
+	inline void thread_pool_public::set_placement(PlacementT placement) noexcept
+	{
+		if (this->m_state_manager.m_multi)
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->set_placement_unchecked(placement);
+		}
+		else
+		{
+			this->set_placement_unchecked(placement);
+		}
+	}
+
+	inline void thread_pool_public::set_autoscale(const AutoscaleT& autoscale) noexcept
+	{
+		if (this->m_state_manager.m_multi)
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->set_autoscale_unchecked(autoscale);
+		}
+		else
+		{
+			this->set_autoscale_unchecked(autoscale);
+		}
+	}
+
+	inline void thread_pool_public::set_bound(const BoundT& bound) noexcept
+	{
+		if (this->m_state_manager.m_multi)
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->set_bound_unchecked(bound);
+		}
+		else
+		{
+			this->set_bound_unchecked(bound);
+		}
+	}
+
+#ifdef _HICXX_TRACE
+	inline void thread_pool_public::set_tracing(bool tracing, size_t capacity) noexcept
+	{
+		if (this->m_state_manager.m_multi)
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->set_tracing_unchecked(tracing, capacity);
+		}
+		else
+		{
+			this->set_tracing_unchecked(tracing, capacity);
+		}
+	}
+
+#endif
+	inline thread_pool_public::MutexManagerT& thread_pool_public::get_mutex_manager_unchecked() noexcept
+	{
+		return this->m_mutex_manager;
+	}
+
+	inline thread_pool_public::DatasManagerT& thread_pool_public::get_datas_manager_unchecked() noexcept
+	{
+		return this->m_datas_manager;
+	}
+
+	inline thread_pool_public::StateManagerT& thread_pool_public::get_state_manager_unchecked() noexcept
+	{
+		return this->m_state_manager;
+	}
+
 	inline const thread_pool_public::MutexManagerT& thread_pool_public::get_mutex_manager_unchecked() const noexcept
 	{
 		return this->m_mutex_manager;
@@ -352,7 +1055,10 @@ namespace HiCxx
 
 	inline thread_pool_public::ThreadNumT thread_pool_public::get_tasks_num_unchecked() const noexcept
 	{
-		return (ThreadNumT)this->m_datas_manager.m_tasks.size();
+		const TaskNumT shared_num = this->m_datas_manager.m_shared_num;
+		const TaskNumT local_num = this->m_datas_manager.m_local_num;
+		const TaskNumT cancelled_num = this->m_datas_manager.m_cancelled_num;
+		return ::std::max((ThreadNumT)(shared_num + local_num - cancelled_num), (ThreadNumT)0);
 	}
 
 	inline thread_pool_public::ThreadNumT thread_pool_public::get_tasks_num() noexcept
@@ -370,7 +1076,7 @@ namespace HiCxx
 
 	inline bool thread_pool_public::is_all_done_unchecked() const noexcept
 	{
-		return (this->m_datas_manager.m_running_num == 0) && (this->m_datas_manager.m_tasks.empty());
+		return (this->get_tasks_num_unchecked() == 0) && (this->m_datas_manager.m_running_num == 0);
 	}
 
 	inline bool thread_pool_public::is_all_done() noexcept
@@ -386,27 +1092,268 @@ namespace HiCxx
 		}
 	}
 
+	inline void thread_pool_public::CountersT::add(AtomicCounterT& counter, CounterT value) noexcept
+	{
+		if (this->m_exclusive)
+			counter.store(counter.load(::std::memory_order_relaxed) + value, ::std::memory_order_relaxed);
+		else
+			counter.fetch_add(value, ::std::memory_order_relaxed);
+	}
+
+	inline void thread_pool_public::CountersT::merge(const CountersT& counters) noexcept
+	{
+		this->m_done_num.fetch_add(counters.m_done_num.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+		this->m_met_num.fetch_add(counters.m_met_num.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+		this->m_late_num.fetch_add(counters.m_late_num.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+		this->m_dropped_num.fetch_add(counters.m_dropped_num.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+	}
+
+	inline void thread_pool_public::CountersT::clear() noexcept
+	{
+		this->m_done_num.store(0, ::std::memory_order_relaxed);
+		this->m_met_num.store(0, ::std::memory_order_relaxed);
+		this->m_late_num.store(0, ::std::memory_order_relaxed);
+		this->m_dropped_num.store(0, ::std::memory_order_relaxed);
+	}
+
+	inline thread_pool_public::DeadlineStatsT thread_pool_public::get_deadline_stats() const noexcept
+	{
+		DeadlineStatsT stats;
+		auto add = [&stats](const CountersT& counters)
+		{
+			stats.m_met_num += counters.m_met_num.load(::std::memory_order_relaxed);
+			stats.m_late_num += counters.m_late_num.load(::std::memory_order_relaxed);
+			stats.m_dropped_num += counters.m_dropped_num.load(::std::memory_order_relaxed);
+		};
+		add(this->m_datas_manager.m_counters);
+		add(this->m_datas_manager.m_retired_counters);
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+			add(ptr->m_counters);
+		return stats;
+	}
+
+	inline void thread_pool_public::reset_deadline_stats() noexcept
+	{
+		auto clear = [](CountersT& counters)
+		{
+			counters.m_met_num.store(0, ::std::memory_order_relaxed);
+			counters.m_late_num.store(0, ::std::memory_order_relaxed);
+			counters.m_dropped_num.store(0, ::std::memory_order_relaxed);
+		};
+		clear(this->m_datas_manager.m_counters);
+		clear(this->m_datas_manager.m_retired_counters);
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+			clear(ptr->m_counters);
+	}
+
+	inline thread_pool_public::OverflowStatsT thread_pool_public::get_overflow_stats() const noexcept
+	{
+		OverflowStatsT stats;
+		stats.m_rejected_num = this->m_datas_manager.m_rejected_num.load(::std::memory_order_relaxed);
+		stats.m_evicted_num = this->m_datas_manager.m_evicted_num.load(::std::memory_order_relaxed);
+		return stats;
+	}
+
+	inline void thread_pool_public::reset_overflow_stats() noexcept
+	{
+		this->m_datas_manager.m_rejected_num.store(0, ::std::memory_order_relaxed);
+		this->m_datas_manager.m_evicted_num.store(0, ::std::memory_order_relaxed);
+	}
+
+#ifdef _HICXX_METRICS
+	inline void thread_pool_public::MetricsT::add(AtomicCounterT& counter, CounterT value) noexcept
+	{
+		if (this->m_exclusive)
+			counter.store(counter.load(::std::memory_order_relaxed) + value, ::std::memory_order_relaxed);
+		else
+			counter.fetch_add(value, ::std::memory_order_relaxed);
+	}
+
+	inline void thread_pool_public::MetricsT::record(histogram& histogram, histogram::ValueT value) noexcept
+	{
+		histogram.record(value, this->m_exclusive);
+	}
+
+	inline void thread_pool_public::MetricsT::merge(const MetricsT& metrics) noexcept
+	{
+		this->m_executed_num.fetch_add(metrics.m_executed_num.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+		this->m_busy_time.fetch_add(metrics.m_busy_time.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+		this->m_stolen_num.fetch_add(metrics.m_stolen_num.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+		this->m_lock_num.fetch_add(metrics.m_lock_num.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+		this->m_contended_num.fetch_add(metrics.m_contended_num.load(::std::memory_order_relaxed), ::std::memory_order_relaxed);
+		this->m_wait_histogram.merge(metrics.m_wait_histogram);
+		this->m_run_histogram.merge(metrics.m_run_histogram);
+	}
+
+	inline void thread_pool_public::MetricsT::clear() noexcept
+	{
+		this->m_executed_num.store(0, ::std::memory_order_relaxed);
+		this->m_busy_time.store(0, ::std::memory_order_relaxed);
+		this->m_stolen_num.store(0, ::std::memory_order_relaxed);
+		this->m_lock_num.store(0, ::std::memory_order_relaxed);
+		this->m_contended_num.store(0, ::std::memory_order_relaxed);
+		this->m_wait_histogram.clear();
+		this->m_run_histogram.clear();
+	}
+
+	inline thread_pool_public::MetricsSnapshotT thread_pool_public::get_metrics_snapshot() const noexcept
+	{
+		MetricsSnapshotT snapshot;
+		snapshot.m_threads_num = this->m_datas_manager.m_threads_num;
+		snapshot.m_running_num = this->m_datas_manager.m_running_num;
+		snapshot.m_idle_num = this->m_datas_manager.m_idle_num;
+		snapshot.m_shared_num = this->m_datas_manager.m_shared_num;
+		snapshot.m_local_num = this->m_datas_manager.m_local_num;
+		snapshot.m_peak_tasks_num = this->m_datas_manager.m_peak_tasks_num.load(::std::memory_order_relaxed);
+
+		auto add = [&snapshot](const MetricsT& metrics)
+		{
+			snapshot.m_executed_num += metrics.m_executed_num.load(::std::memory_order_relaxed);
+			snapshot.m_busy_time += metrics.m_busy_time.load(::std::memory_order_relaxed);
+			snapshot.m_stolen_num += metrics.m_stolen_num.load(::std::memory_order_relaxed);
+			snapshot.m_lock_num += metrics.m_lock_num.load(::std::memory_order_relaxed);
+			snapshot.m_contended_num += metrics.m_contended_num.load(::std::memory_order_relaxed);
+			metrics.m_wait_histogram.snapshot(snapshot.m_wait_histogram);
+			metrics.m_run_histogram.snapshot(snapshot.m_run_histogram);
+		};
+		add(this->m_datas_manager.m_metrics);
+		add(this->m_datas_manager.m_retired_metrics);
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+		{
+			add(ptr->m_metrics);
+			snapshot.m_workers.push_back(WorkerMetricsT{ ptr->m_cpu, ptr->m_enable.load(::std::memory_order_relaxed),
+				ptr->m_metrics.m_executed_num.load(::std::memory_order_relaxed),
+				ptr->m_metrics.m_busy_time.load(::std::memory_order_relaxed),
+				ptr->m_metrics.m_stolen_num.load(::std::memory_order_relaxed) });
+		}
+		return snapshot;
+	}
+
+	inline void thread_pool_public::reset_metrics() noexcept
+	{
+		this->m_datas_manager.m_peak_tasks_num.store(0, ::std::memory_order_relaxed);
+		this->m_datas_manager.m_metrics.clear();
+		this->m_datas_manager.m_retired_metrics.clear();
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+			ptr->m_metrics.clear();
+	}
+
+#endif
+#ifdef _HICXX_TRACE
+	inline void thread_pool_public::TraceRingT::allocate(size_t capacity) noexcept
+	{
+		if (this->m_events)
+			return;
+
+		size_t size = 1;
+		while (size < capacity)
+			size <<= 1;
+		this->m_events.reset(new TraceEventT[size]);
+		this->m_capacity = size;
+	}
+
+	inline void thread_pool_public::TraceRingT::push(const TraceEventT& event) noexcept
+	{
+		const CounterT written = this->m_written.load(::std::memory_order_relaxed);
+		this->m_events[(size_t)written & (this->m_capacity - 1)] = event;
+		this->m_written.store(written + 1, ::std::memory_order_release);
+	}
+
+	inline bool thread_pool_public::dump_trace(const char* path) const noexcept
+	{
+		::FILE* file = ::fopen(path, "w");
+		if (!file)
+			return false;
+
+		using MicrosecondsT = ::std::chrono::duration<double, ::std::micro>;
+		TimePointT base = TimePointT::max();
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+		{
+			const CounterT written = ptr->m_trace.m_written.load(::std::memory_order_acquire);
+			for (CounterT i = written > ptr->m_trace.m_capacity ? written - ptr->m_trace.m_capacity : 0; i < written; ++i)
+			{
+				const TraceEventT& event = ptr->m_trace.m_events[(size_t)i & (ptr->m_trace.m_capacity - 1)];
+				const TimePointT time = event.m_enqueue_time != TimePointT{} ? event.m_enqueue_time : event.m_begin_time;
+				if (time < base)
+					base = time;
+			}
+		}
+
+		::std::string text = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+			"{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"run\"}},\n"
+			"{\"ph\":\"M\",\"pid\":2,\"name\":\"process_name\",\"args\":{\"name\":\"queue\"}}";
+		char buffer[256];
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+		{
+			::snprintf(buffer, sizeof(buffer), ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":\"worker %d\"}}",
+				(int)ptr->m_index, (int)ptr->m_index);
+			text += buffer;
+
+			const CounterT written = ptr->m_trace.m_written.load(::std::memory_order_acquire);
+			for (CounterT i = written > ptr->m_trace.m_capacity ? written - ptr->m_trace.m_capacity : 0; i < written; ++i)
+			{
+				const TraceEventT& event = ptr->m_trace.m_events[(size_t)i & (ptr->m_trace.m_capacity - 1)];
+				const double begin = MicrosecondsT(event.m_begin_time - base).count();
+				const double duration = MicrosecondsT(event.m_end_time - event.m_begin_time).count();
+				const double wait = event.m_enqueue_time != TimePointT{} ? MicrosecondsT(event.m_begin_time - event.m_enqueue_time).count() : 0.0;
+				text += ",\n{\"ph\":\"X\",\"cat\":\"task\",\"pid\":1,\"name\":";
+				write_trace_label(text, event.m_label);
+				::snprintf(buffer, sizeof(buffer), ",\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"wait_us\":%.3f}}",
+					(int)ptr->m_index, begin, duration, wait);
+				text += buffer;
+				if (event.m_enqueue_time == TimePointT{})
+					continue;
+
+				text += ",\n{\"ph\":\"X\",\"cat\":\"queue\",\"pid\":2,\"name\":";
+				write_trace_label(text, event.m_label);
+				::snprintf(buffer, sizeof(buffer), ",\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+					(int)ptr->m_index, MicrosecondsT(event.m_enqueue_time - base).count(), wait);
+				text += buffer;
+			}
+		}
+		text += "\n]}\n";
+
+		const bool complete = ::fwrite(text.data(), 1, text.size(), file) == text.size();
+		return (::fclose(file) == 0) && complete;
+	}
+
+	inline void thread_pool_public::clear_trace() noexcept
+	{
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+			ptr->m_trace.m_written.store(0, ::std::memory_order_release);
+	}
+
+#endif
 	inline void thread_pool_public::wait_all_done_unchecked(bool wait_when_stop) noexcept
 	{
+		if (this->is_all_done_unchecked())
+			return;
+
 		UniqueLockT lock(this->m_mutex_manager.m_mutex);
+		++this->m_datas_manager.m_waiter_num;
 		this->m_mutex_manager.m_wait_condition.wait(lock,
 			[this, wait_when_stop]() { return (wait_when_stop && this->m_state_manager.m_stopped) || this->is_all_done_unchecked(); });
+		--this->m_datas_manager.m_waiter_num;
 	}
 
 	template<class _TTimePoint>
 	inline bool thread_pool_public::wait_until_all_done_unchecked(const _TTimePoint& time_point, bool wait_when_stop) noexcept
 	{
+		if (this->is_all_done_unchecked())
+			return true;
+
 		UniqueLockT lock(this->m_mutex_manager.m_mutex);
-		return (bool)this->m_mutex_manager.m_wait_condition.wait_until(lock, time_point,
+		++this->m_datas_manager.m_waiter_num;
+		const bool done = (bool)this->m_mutex_manager.m_wait_condition.wait_until(lock, time_point,
 			[this, wait_when_stop]() { return (wait_when_stop && this->m_state_manager.m_stopped) || this->is_all_done_unchecked(); });
+		--this->m_datas_manager.m_waiter_num;
+		return done;
 	}
 
 	template<class _TDuration>
 	inline bool thread_pool_public::wait_for_all_done_unchecked(const _TDuration& duration, bool wait_when_stop) noexcept
 	{
-		UniqueLockT lock(this->m_mutex_manager.m_mutex);
-		return (bool)this->m_mutex_manager.m_wait_condition.wait_for(lock, duration,
-			[this, wait_when_stop]() { return (wait_when_stop && this->m_state_manager.m_stopped) || this->is_all_done_unchecked(); });
+		return this->wait_until_all_done_unchecked(ClockT::now() + duration, wait_when_stop);
 	}
 
 	inline void thread_pool_public::wait_all_done(bool wait_when_stop) noexcept
@@ -414,7 +1361,7 @@ namespace HiCxx
 		if (wait_when_stop && this->m_state_manager.m_stopped)
 			return;
 
-		this->wait_all_done_unchecked();
+		this->wait_all_done_unchecked(wait_when_stop);
 	}
 
 	template<class _TTimePoint>
@@ -439,53 +1386,36 @@ namespace HiCxx
 	inline auto thread_pool_public::submit_unchecked(const TimePointT& expiration_time, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
 		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
 	{
-		using ReturnT = decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...));
-		auto task = ::std::make_shared<PackagedTaskT<ReturnT>>(::std::bind(::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...));
-		this->m_datas_manager.m_tasks.insert({ expiration_time, priority, submit_on_expiration, [task]() { (*task)(); } });
-		this->m_mutex_manager.m_task_condition.notify_one();
-		return task->get_future();
+		TaskT task{ {}, expiration_time, priority, submit_on_expiration };
+		auto future = this->package_task(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		this->push_task_unchecked(::std::move(task));
+		return future;
 	}
 
 	template<class _TFunc, class..._TArgs>
 	inline auto thread_pool_public::submit_unchecked(const DurationT& expiration_time_length, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
 		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
 	{
-		using ReturnT = decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...));
-		auto task = ::std::make_shared<PackagedTaskT<ReturnT>>(::std::bind(::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...));
-		this->m_datas_manager.m_tasks.insert({ (submit_on_expiration ? TimePointT{} : (::std::chrono::steady_clock::now() + expiration_time_length)), priority,
-			submit_on_expiration, [task]() { (*task)(); } });
-		this->m_mutex_manager.m_task_condition.notify_one();
-		return task->get_future();
+		return this->submit_unchecked((submit_on_expiration ? TimePointT{} : (ClockT::now() + expiration_time_length)), priority, submit_on_expiration,
+			::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
 	}
 
 	template<class _TFunc, class..._TArgs>
 	inline auto thread_pool_public::submit(const TimePointT& expiration_time, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
 		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
 	{
-		if (this->m_state_manager.m_multi)
-		{
-			LockGuardT lock(m_mutex_manager.m_mutex);
-			return this->submit_unchecked(expiration_time, priority, submit_on_expiration, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
-		}
-		else
-		{
-			return this->submit_unchecked(expiration_time, priority, submit_on_expiration, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
-		}
+		TaskT task{ {}, expiration_time, priority, submit_on_expiration };
+		auto future = this->package_task(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		this->push_task(::std::move(task));
+		return future;
 	}
 
 	template<class _TFunc, class..._TArgs>
 	inline auto thread_pool_public::submit(const DurationT& expiration_time_length, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
 		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
 	{
-		if (this->m_state_manager.m_multi)
-		{
-			LockGuardT lock(m_mutex_manager.m_mutex);
-			return this->submit_unchecked(expiration_time_length, priority, submit_on_expiration, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
-		}
-		else
-		{
-			return this->submit_unchecked(expiration_time_length, priority, submit_on_expiration, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
-		}
+		return this->submit((submit_on_expiration ? TimePointT{} : (ClockT::now() + expiration_time_length)), priority, submit_on_expiration,
+			::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
 	}
 
 	template<class _TFunc, class..._TArgs>
@@ -516,84 +1446,1952 @@ namespace HiCxx
 		return this->submit(TimePointT{}, (PriorityT)0, true, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
 	}
 
-	template<class..._TArgs>
-	inline auto thread_pool_public::execute(_TArgs&&... args) noexcept
-		->decltype(this->submit(::std::forward<_TArgs>(args)...))
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_unchecked(const TimePointT& expiration_time, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)))
 	{
-		return this->submit(::std::forward<_TArgs>(args)...);
+		TaskT task{ {}, expiration_time, priority, submit_on_expiration };
+		this->package_post(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		this->push_task_unchecked(::std::move(task));
 	}
 
-	inline bool thread_pool_public::get_task(TaskT& task) noexcept
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_unchecked(const DurationT& expiration_time_length, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)))
 	{
-		if (this->m_state_manager.m_stopped || this->m_state_manager.m_pausing)
-			return false;
+		this->post_unchecked((submit_on_expiration ? TimePointT{} : (ClockT::now() + expiration_time_length)), priority, submit_on_expiration,
+			::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
 
-		UniqueLockT lock(this->m_mutex_manager.m_mutex);
-		if (this->m_datas_manager.m_tasks.empty())
-			this->m_mutex_manager.m_task_condition.wait(lock, [this]() { return this->m_state_manager.m_stopped || this->m_state_manager.m_pausing || !this->m_datas_manager.m_tasks.empty(); });
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post(const TimePointT& expiration_time, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		TaskT task{ {}, expiration_time, priority, submit_on_expiration };
+		this->package_post(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		return this->push_task(::std::move(task));
+	}
 
-		if (this->m_state_manager.m_stopped || this->m_state_manager.m_pausing)
-			return false;
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post(const DurationT& expiration_time_length, PriorityT priority, bool submit_on_expiration, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post((submit_on_expiration ? TimePointT{} : (ClockT::now() + expiration_time_length)), priority, submit_on_expiration,
+			::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post(const TimePointT& expiration_time, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post(expiration_time, priority, false, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post(const DurationT& expiration_time_length, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post(expiration_time_length, priority, false, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post(TimePointT{}, priority, true, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post(_TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post(TimePointT{}, (PriorityT)0, true, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
 
-		auto ptr = this->m_datas_manager.m_tasks.begin();
-		task = ::std::move(const_cast<TaskT&>(*ptr));
-		this->m_datas_manager.m_tasks.erase(ptr);
+	template<class..._TArgs>
+	inline void thread_pool_public::execute(_TArgs&&... args) noexcept
+	{
+		this->post(::std::forward<_TArgs>(args)...);
+	}
 
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_local(_TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		TaskT task{ {}, TimePointT{}, 0, true };
+		this->package_post(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		if (!this->m_datas_manager.m_workers)
+			return this->push_task(::std::move(task));
+		this->push_local_task(::std::move(task));
 		return true;
 	}
 
-	inline void thread_pool_public::mission(ThreadPtrT ptr) noexcept
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_traced(const char* label, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
 	{
-		TaskT task;
-		while (!this->m_state_manager.m_stopped)
-		{
-			{
-				if (this->m_datas_manager.m_delete_num)
-				{
-					LockGuardT lock(this->m_mutex_manager.m_mutex);
-					this->m_datas_manager.m_threads.erase(ptr->m_thread.get_id());
-					--this->m_datas_manager.m_delete_num;
-				}
-				if (this->m_state_manager.m_pausing)
-				{
-					UniqueLockT lock(this->m_mutex_manager.m_mutex);
-					m_mutex_manager.m_pause_condition.wait(lock);
-				}
-			}
-			if (this->get_task(task))
-			{
-				++this->m_datas_manager.m_running_num;
-				if (this->m_state_manager.m_try_mode)
-				{
-					try
-					{
-						if (task.m_submit_on_expiration || ::std::chrono::steady_clock::now() <= task.m_expiration_time)
-						{
-							task.m_function();
-						}
-					}
-					catch (const ::std::exception& exception)
-					{
-						const auto id = ptr->m_thread.get_id();
-						::fprintf(stderr, "HiCxx: thread_pool_public[%d] caught exception\nwhat():%s\n", *(int*)(&id), exception.what());
-					}
-				}
-				else
-				{
-					if (task.m_submit_on_expiration || ::std::chrono::steady_clock::now() <= task.m_expiration_time)
-					{
-						task.m_function();
-					}
-				}
-				--this->m_datas_manager.m_running_num;
-				if ((this->m_datas_manager.m_running_num == 0) && (this->m_datas_manager.m_tasks.empty()) || this->m_state_manager.m_pausing)
-					this->m_mutex_manager.m_wait_condition.notify_all();
-			}
-			else if (!this->m_state_manager.m_stopped && !this->m_state_manager.m_pausing)
+		TaskT task{ {}, TimePointT{}, priority, true };
+		set_label(task, label);
+		auto future = this->package_task(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		this->push_task(::std::move(task));
+		return future;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_traced(const char* label, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit_traced(label, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_traced(const char* label, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		set_label(task, label);
+		this->package_post(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		return this->push_task(::std::move(task));
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_traced(const char* label, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post_traced(label, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_cancellable(CancelTokenT& token, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		auto future = this->package_task(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		token = this->package_cancellable(task, nullptr);
+		this->push_task(::std::move(task));
+		return future;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_cancellable(CancelTokenT& token, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit_cancellable(token, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_cancellable(CancelTokenT& token, const CancelGroupT& group, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		auto future = this->package_task(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		token = this->package_cancellable(task, &group);
+		this->push_task(::std::move(task));
+		return future;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_cancellable(CancelTokenT& token, const CancelGroupT& group, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit_cancellable(token, group, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_cancellable(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), CancelTokenT{})
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		this->package_post(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		CancelTokenT token = this->package_cancellable(task, nullptr);
+		this->push_task(::std::move(task));
+		return token;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_cancellable(_TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), CancelTokenT{})
+	{
+		return this->post_cancellable(0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_cancellable(const CancelGroupT& group, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), CancelTokenT{})
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		this->package_post(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		CancelTokenT token = this->package_cancellable(task, &group);
+		this->push_task(::std::move(task));
+		return token;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_cancellable(const CancelGroupT& group, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), CancelTokenT{})
+	{
+		return this->post_cancellable(group, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	inline thread_pool_public::CancelGroupT thread_pool_public::make_cancel_group() noexcept
+	{
+		return CancelGroupT{ ::std::make_shared<CancelGroupStateT>() };
+	}
+
+	inline bool thread_pool_public::is_cancel_requested() noexcept
+	{
+		const CancelStateT* state = get_current_cancel();
+		return state && state->m_status.load(::std::memory_order_relaxed) == CancelStatusT::cancelling;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::try_submit(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit_for(DurationT::zero(), priority, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::try_submit(_TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit_for(DurationT::zero(), (PriorityT)0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_for(const DurationT& duration, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		auto future = this->package_task(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		if (!this->push_task(::std::move(task), ClockT::now() + duration))
+			return {};
+		return future;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_for(const DurationT& duration, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit_for(duration, (PriorityT)0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::try_post(PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post_for(DurationT::zero(), priority, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::try_post(_TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post_for(DurationT::zero(), (PriorityT)0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_for(const DurationT& duration, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		this->package_post(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		return this->push_task(::std::move(task), ClockT::now() + duration);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_for(const DurationT& duration, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post_for(duration, (PriorityT)0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	inline thread_pool_public::QueueIdT thread_pool_public::create_queue(const char* name, ::uint32_t weight, ThreadNumT max_running) noexcept
+	{
+		LockGuardT lock(this->m_mutex_manager.m_mutex);
+		this->ensure_default_queue_unchecked();
+		const size_t num = this->m_datas_manager.m_queues_num;
+		if (num == queues_max)
+			return queue_npos;
+
+		QueuePtrT queue(new QueueT());
+		queue->m_id = num;
+		queue->m_name = name ? name : "";
+		queue->m_weight = ::std::max(weight, (::uint32_t)1);
+		queue->m_max_running = ::std::max(max_running, (ThreadNumT)0);
+		queue->m_tasks.set_edf(this->m_state_manager.m_edf);
+		queue->m_tasks.set_aging(this->m_state_manager.m_aging);
+		this->m_datas_manager.m_queues[num] = ::std::move(queue);
+		this->m_datas_manager.m_queues_num.store(num + 1, ::std::memory_order_release);
+		return num;
+	}
+
+	inline bool thread_pool_public::set_queue(QueueIdT id, ::uint32_t weight, ThreadNumT max_running) noexcept
+	{
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->ensure_default_queue_unchecked();
+			if (id >= this->m_datas_manager.m_queues_num)
+				return false;
+
+			QueueT& queue = *this->m_datas_manager.m_queues[id];
+			queue.m_weight = ::std::max(weight, (::uint32_t)1);
+			queue.m_max_running = ::std::max(max_running, (ThreadNumT)0);
+		}
+		this->m_mutex_manager.m_task_condition.notify_all();
+		return true;
+	}
+
+	inline thread_pool_public::QueueIdT thread_pool_public::find_queue(const char* name) noexcept
+	{
+		LockGuardT lock(this->m_mutex_manager.m_mutex);
+		for (size_t i = 0; i < this->m_datas_manager.m_queues_num; ++i)
+		{
+			if (this->m_datas_manager.m_queues[i]->m_name == name)
+				return i;
+		}
+		return queue_npos;
+	}
+
+	inline ::std::vector<thread_pool_public::QueueStatsT> thread_pool_public::get_queue_stats() noexcept
+	{
+		::std::vector<QueueStatsT> stats;
+		LockGuardT lock(this->m_mutex_manager.m_mutex);
+		for (size_t i = 0; i < this->m_datas_manager.m_queues_num; ++i)
+		{
+			const QueueT& queue = *this->m_datas_manager.m_queues[i];
+			stats.emplace_back();
+			QueueStatsT& stat = stats.back();
+			stat.m_id = queue.m_id;
+			stat.m_name = queue.m_name;
+			stat.m_weight = queue.m_weight;
+			stat.m_max_running = queue.m_max_running;
+			stat.m_queued_num = (TaskNumT)this->get_task_queue(&queue).size();
+			stat.m_running_num = queue.m_running_num;
+			stat.m_submitted_num = queue.m_submitted_num.load(::std::memory_order_relaxed);
+			stat.m_executed_num = queue.m_executed_num.load(::std::memory_order_relaxed);
+			stat.m_busy_time = queue.m_busy_time.load(::std::memory_order_relaxed);
+#ifdef _HICXX_METRICS
+			queue.m_wait_histogram.snapshot(stat.m_wait_histogram);
+#endif
+		}
+		return stats;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_to(QueueIdT queue, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		task.m_queue = this->get_queue(queue);
+		auto future = this->package_task(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		this->push_task(::std::move(task));
+		return future;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_to(QueueIdT queue, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit_to(queue, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_to(QueueIdT queue, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		task.m_queue = this->get_queue(queue);
+		this->package_post(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		return this->push_task(::std::move(task));
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_to(QueueIdT queue, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), true)
+	{
+		return this->post_to(queue, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_at(const TimePointT& time, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		auto future = this->package_task(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		this->insert_timer(time, DurationT::zero(), TimerT{ ::std::move(task.m_function), nullptr, priority, TimerModeT::once });
+		return future;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_at(const TimePointT& time, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit_at(time, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_after(const DurationT& delay, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit_at(ClockT::now() + delay, priority, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::submit_after(const DurationT& delay, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		return this->submit_at(ClockT::now() + delay, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_at(const TimePointT& time, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), TimerIdT{})
+	{
+		TaskT task{ {}, TimePointT{}, priority, true };
+		this->package_post(task, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+		return this->insert_timer(time, DurationT::zero(), TimerT{ ::std::move(task.m_function), nullptr, priority, TimerModeT::once });
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_at(const TimePointT& time, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), TimerIdT{})
+	{
+		return this->post_at(time, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_after(const DurationT& delay, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), TimerIdT{})
+	{
+		return this->post_at(ClockT::now() + delay, priority, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_after(const DurationT& delay, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...)), TimerIdT{})
+	{
+		return this->post_at(ClockT::now() + delay, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_periodic(const DurationT& period, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(function(args...)), TimerIdT{})
+	{
+		return this->insert_timer(ClockT::now() + period, period,
+			TimerT{ {}, package_periodic(::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...), priority, TimerModeT::fixed_delay });
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_periodic(const DurationT& period, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(function(args...)), TimerIdT{})
+	{
+		return this->post_periodic(period, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_fixed_rate(const DurationT& period, PriorityT priority, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(function(args...)), TimerIdT{})
+	{
+		return this->insert_timer(ClockT::now() + period, period,
+			TimerT{ {}, package_periodic(::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...), priority, TimerModeT::fixed_rate });
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::post_fixed_rate(const DurationT& period, _TFunc&& function, _TArgs&&... args) noexcept
+		-> decltype(void(function(args...)), TimerIdT{})
+	{
+		return this->post_fixed_rate(period, 0, ::std::forward<_TFunc>(function), ::std::forward<_TArgs>(args)...);
+	}
+
+	inline bool thread_pool_public::cancel_timer(TimerIdT id) noexcept
+	{
+		LockGuardT lock(this->m_mutex_manager.m_timer_mutex);
+		return this->m_datas_manager.m_timers.cancel(id);
+	}
+
+	inline size_t thread_pool_public::get_timers_num() noexcept
+	{
+		LockGuardT lock(this->m_mutex_manager.m_timer_mutex);
+		return this->m_datas_manager.m_timers.size();
+	}
+
+#ifdef _HICXX_COROUTINE
+	inline thread_pool_public::ScheduleAwaiterT thread_pool_public::schedule(PriorityT priority) noexcept
+	{
+		return ScheduleAwaiterT{ *this, priority };
+	}
+
+#endif
+	template<class _TIter>
+	inline auto thread_pool_public::submit_bulk_unchecked(PriorityT priority, _TIter first, _TIter last) noexcept
+		-> ::std::vector<FutureT<decltype((*first)())>>
+	{
+		::std::vector<FutureT<decltype((*first)())>> futures;
+		TaskVectorT tasks;
+		for (; first != last; ++first)
+		{
+			tasks.push_back({ {}, TimePointT{}, priority, true });
+			futures.push_back(this->package_task(tasks.back(), *first));
+		}
+		this->push_tasks_unchecked(tasks);
+		return futures;
+	}
+
+	template<class _TGenerator>
+	inline auto thread_pool_public::submit_bulk_unchecked(PriorityT priority, size_t num, _TGenerator&& generator) noexcept
+		-> ::std::vector<FutureT<decltype(generator(size_t{})())>>
+	{
+		::std::vector<FutureT<decltype(generator(size_t{})())>> futures;
+		futures.reserve(num);
+		TaskVectorT tasks(num);
+		for (size_t i = 0; i < num; ++i)
+		{
+			tasks[i] = { {}, TimePointT{}, priority, true };
+			futures.push_back(this->package_task(tasks[i], generator(i)));
+		}
+		this->push_tasks_unchecked(tasks);
+		return futures;
+	}
+
+	template<class _TIter>
+	inline auto thread_pool_public::execute_bulk_unchecked(PriorityT priority, _TIter first, _TIter last) noexcept
+		-> decltype(void((*first)()))
+	{
+		TaskVectorT tasks;
+		for (; first != last; ++first)
+		{
+			tasks.push_back({ {}, TimePointT{}, priority, true });
+			this->package_post(tasks.back(), *first);
+		}
+		this->push_tasks_unchecked(tasks);
+	}
+
+	template<class _TGenerator>
+	inline auto thread_pool_public::execute_bulk_unchecked(PriorityT priority, size_t num, _TGenerator&& generator) noexcept
+		-> decltype(void(generator(size_t{})()))
+	{
+		TaskVectorT tasks(num);
+		for (size_t i = 0; i < num; ++i)
+		{
+			tasks[i] = { {}, TimePointT{}, priority, true };
+			this->package_post(tasks[i], generator(i));
+		}
+		this->push_tasks_unchecked(tasks);
+	}
+
+	template<class _TIter>
+	inline auto thread_pool_public::submit_bulk(PriorityT priority, _TIter first, _TIter last) noexcept
+		-> ::std::vector<FutureT<decltype((*first)())>>
+	{
+		::std::vector<FutureT<decltype((*first)())>> futures;
+		TaskVectorT tasks;
+		for (; first != last; ++first)
+		{
+			tasks.push_back({ {}, TimePointT{}, priority, true });
+			futures.push_back(this->package_task(tasks.back(), *first));
+		}
+		this->push_tasks(tasks);
+		return futures;
+	}
+
+	template<class _TGenerator>
+	inline auto thread_pool_public::submit_bulk(PriorityT priority, size_t num, _TGenerator&& generator) noexcept
+		-> ::std::vector<FutureT<decltype(generator(size_t{})())>>
+	{
+		::std::vector<FutureT<decltype(generator(size_t{})())>> futures;
+		futures.reserve(num);
+		TaskVectorT tasks(num);
+		for (size_t i = 0; i < num; ++i)
+		{
+			tasks[i] = { {}, TimePointT{}, priority, true };
+			futures.push_back(this->package_task(tasks[i], generator(i)));
+		}
+		this->push_tasks(tasks);
+		return futures;
+	}
+
+	template<class _TIter>
+	inline auto thread_pool_public::submit_bulk(_TIter first, _TIter last) noexcept
+		-> ::std::vector<FutureT<decltype((*first)())>>
+	{
+		return this->submit_bulk((PriorityT)0, first, last);
+	}
+
+	template<class _TGenerator>
+	inline auto thread_pool_public::submit_bulk(size_t num, _TGenerator&& generator) noexcept
+		-> ::std::vector<FutureT<decltype(generator(size_t{})())>>
+	{
+		return this->submit_bulk((PriorityT)0, num, ::std::forward<_TGenerator>(generator));
+	}
+
+	template<class _TIter>
+	inline auto thread_pool_public::execute_bulk(PriorityT priority, _TIter first, _TIter last) noexcept
+		-> decltype(void((*first)()))
+	{
+		TaskVectorT tasks;
+		for (; first != last; ++first)
+		{
+			tasks.push_back({ {}, TimePointT{}, priority, true });
+			this->package_post(tasks.back(), *first);
+		}
+		this->push_tasks(tasks);
+	}
+
+	template<class _TGenerator>
+	inline auto thread_pool_public::execute_bulk(PriorityT priority, size_t num, _TGenerator&& generator) noexcept
+		-> decltype(void(generator(size_t{})()))
+	{
+		TaskVectorT tasks(num);
+		for (size_t i = 0; i < num; ++i)
+		{
+			tasks[i] = { {}, TimePointT{}, priority, true };
+			this->package_post(tasks[i], generator(i));
+		}
+		this->push_tasks(tasks);
+	}
+
+	template<class _TIter>
+	inline auto thread_pool_public::execute_bulk(_TIter first, _TIter last) noexcept
+		-> decltype(void((*first)()))
+	{
+		this->execute_bulk((PriorityT)0, first, last);
+	}
+
+	template<class _TGenerator>
+	inline auto thread_pool_public::execute_bulk(size_t num, _TGenerator&& generator) noexcept
+		-> decltype(void(generator(size_t{})()))
+	{
+		this->execute_bulk((PriorityT)0, num, ::std::forward<_TGenerator>(generator));
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline auto thread_pool_public::package_task(TaskT& task, _TFunc&& function, _TArgs&&... args) noexcept
+		-> FutureT<decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...))>
+	{
+		using ReturnT = decltype(::std::forward<_TFunc>(function)(::std::forward<_TArgs>(args)...));
+		PromiseT<ReturnT> promise;
+		FutureT<ReturnT> future = promise.get_future();
+		task.m_function = [promise = ::std::move(promise), function = ::std::forward<_TFunc>(function), arguments = ::std::make_tuple(::std::forward<_TArgs>(args)...)]() mutable
+		{
+			promise.set_result([&]() -> ReturnT { return ::std::apply(::std::move(function), ::std::move(arguments)); });
+		};
+		return future;
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline void thread_pool_public::package_post(TaskT& task, _TFunc&& function, _TArgs&&... args) noexcept
+	{
+		task.m_function = [function = ::std::forward<_TFunc>(function), arguments = ::std::make_tuple(::std::forward<_TArgs>(args)...)]() mutable
+		{
+			::std::apply(::std::move(function), ::std::move(arguments));
+		};
+	}
+
+	template<class _TFunc, class..._TArgs>
+	inline thread_pool_public::SharedFunctionT thread_pool_public::package_periodic(_TFunc&& function, _TArgs&&... args) noexcept
+	{
+		return ::std::make_shared<FuncionT>([function = ::std::forward<_TFunc>(function), arguments = ::std::make_tuple(::std::forward<_TArgs>(args)...)]() mutable
+			{
+				::std::apply(function, arguments);
+			});
+	}
+
+	inline void thread_pool_public::report_exception(const char* what) noexcept
+	{
+		const auto id = ::std::this_thread::get_id();
+		::fprintf(stderr, "HiCxx: thread_pool_public[%d] caught exception\nwhat():%s\n", *(int*)(&id), what);
+	}
+
+	inline thread_pool_public::UniqueLockT thread_pool_public::lock_tasks() noexcept
+	{
+#ifdef _HICXX_METRICS
+		UniqueLockT lock(this->m_mutex_manager.m_mutex, ::std::try_to_lock);
+		MetricsT& metrics = this->get_metrics();
+		metrics.add(metrics.m_lock_num, 1);
+		if (!lock.owns_lock())
+		{
+			metrics.add(metrics.m_contended_num, 1);
+			lock.lock();
+		}
+		return lock;
+#else
+		return UniqueLockT(this->m_mutex_manager.m_mutex);
+#endif
+	}
+
+	inline void thread_pool_public::stamp_task(TaskT& task) noexcept
+	{
+#ifdef _HICXX_TASK_TIMESTAMP
+		task.m_enqueue_time = ClockT::now();
+#else
+		(void)task;
+#endif
+	}
+
+	inline void thread_pool_public::stamp_tasks(TaskVectorT& tasks) noexcept
+	{
+#ifdef _HICXX_TASK_TIMESTAMP
+		const TimePointT now = ClockT::now();
+		for (TaskT& task : tasks)
+			task.m_enqueue_time = now;
+#else
+		(void)tasks;
+#endif
+	}
+
+	inline void thread_pool_public::set_label(TaskT& task, const char* label) noexcept
+	{
+#ifdef _HICXX_TRACE
+		task.m_label = label;
+#else
+		(void)task;
+		(void)label;
+#endif
+	}
+
+	inline thread_pool_public::CancelTokenT thread_pool_public::package_cancellable(TaskT& task, const CancelGroupT* group) noexcept
+	{
+		CancelStatePtrT state = ::std::make_shared<CancelStateT>();
+		state->m_function = ::std::move(task.m_function);
+		state->m_pool = this;
+		task.m_cancel = state;
+		if (group && group->valid())
+			group->add(state);
+		return CancelTokenT{ ::std::move(state) };
+	}
+
+	inline bool thread_pool_public::cancel_task(CancelStateT& state) noexcept
+	{
+		CancelStatusT status = CancelStatusT::queued;
+		if (state.m_status.compare_exchange_strong(status, CancelStatusT::cancelled))
+		{
+			ThreadPoolT* pool = state.m_pool;
+			++pool->m_datas_manager.m_cancelled_num;
+			state.m_function.reset();
+			pool->notify_space();
+			if (pool->is_all_done_unchecked())
+				pool->notify_done();
+			return true;
+		}
+		if (status == CancelStatusT::running)
+			state.m_status.compare_exchange_strong(status, CancelStatusT::cancelling);
+		return false;
+	}
+
+	inline bool thread_pool_public::claim_task(TaskT& task) noexcept
+	{
+		if (!task.m_cancel)
+			return true;
+
+		CancelStatusT status = CancelStatusT::queued;
+		if (task.m_cancel->m_status.compare_exchange_strong(status, CancelStatusT::running))
+		{
+			task.m_function = ::std::move(task.m_cancel->m_function);
+			return true;
+		}
+		--this->m_datas_manager.m_cancelled_num;
+		task.m_cancel.reset();
+		return false;
+	}
+
+	inline void thread_pool_public::drop_task(TaskT& task) noexcept
+	{
+		if (!task.m_cancel)
+			return;
+
+		CancelStatusT status = CancelStatusT::queued;
+		if (task.m_cancel->m_status.compare_exchange_strong(status, CancelStatusT::finished))
+			task.m_cancel->m_function.reset();
+		else
+			--this->m_datas_manager.m_cancelled_num;
+		task.m_cancel.reset();
+	}
+
+	inline thread_pool_public::CancelStateT*& thread_pool_public::get_current_cancel() noexcept
+	{
+		static thread_local CancelStateT* state = nullptr;
+		return state;
+	}
+
+#ifdef _HICXX_COROUTINE
+	inline thread_pool_public::HandleVectorT& thread_pool_public::get_dropped_handles() noexcept
+	{
+		static thread_local HandleVectorT handles;
+		return handles;
+	}
+
+#endif
+	inline void thread_pool_public::resume_dropped() noexcept
+	{
+#ifdef _HICXX_COROUTINE
+		HandleVectorT& handles = get_dropped_handles();
+		while (!handles.empty())
+		{
+			HandleVectorT dropped;
+			dropped.swap(handles);
+			for (::std::coroutine_handle<> handle : dropped)
+				handle.resume();
+		}
+#endif
+	}
+
+#ifdef _HICXX_TRACE
+	inline void thread_pool_public::record_trace(const TaskT& task, const TimePointT& begin_time, const TimePointT& end_time) noexcept
+	{
+		ThreadPtrT ptr = get_current_worker();
+		if (!ptr || ptr->m_pool != this || !ptr->m_trace.m_events)
+			return;
+
+		ptr->m_trace.push(TraceEventT{ task.m_label, task.m_enqueue_time, begin_time, end_time });
+	}
+
+	inline void thread_pool_public::write_trace_label(::std::string& text, const char* label) noexcept
+	{
+		text += '"';
+		for (const char* c = label ? label : "task"; *c; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+				text += '\\';
+			if ((unsigned char)*c >= 0x20)
+				text += *c;
+		}
+		text += '"';
+	}
+
+#endif
+#ifdef _HICXX_METRICS
+	inline thread_pool_public::MetricsT& thread_pool_public::get_metrics() noexcept
+	{
+		ThreadPtrT ptr = get_current_worker();
+		return (ptr && ptr->m_pool == this) ? ptr->m_metrics : this->m_datas_manager.m_metrics;
+	}
+
+#endif
+	inline thread_pool_public::CountersT& thread_pool_public::get_counters() noexcept
+	{
+		ThreadPtrT ptr = get_current_worker();
+		return (ptr && ptr->m_pool == this) ? ptr->m_counters : this->m_datas_manager.m_counters;
+	}
+
+	inline thread_pool_public::CounterT thread_pool_public::get_done_num() const noexcept
+	{
+		CounterT done_num = this->m_datas_manager.m_counters.m_done_num.load(::std::memory_order_relaxed)
+			+ this->m_datas_manager.m_retired_counters.m_done_num.load(::std::memory_order_relaxed);
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+			done_num += ptr->m_counters.m_done_num.load(::std::memory_order_relaxed);
+		return done_num;
+	}
+
+	inline bool thread_pool_public::is_local_task(const TaskT& task) const noexcept
+	{
+		if ((task.m_priority != 0) || task.m_queue || (this->m_datas_manager.m_workers == nullptr)
+			|| (this->m_state_manager.m_edf && task.has_deadline()))
+			return false;
+		if (this->m_state_manager.m_stealing.load(::std::memory_order_relaxed))
+			return true;
+		if (!this->m_state_manager.m_local_submit)
+			return false;
+
+		ThreadPtrT ptr = get_current_worker();
+		return ptr && ptr->m_pool == this;
+	}
+
+	inline thread_pool_public::QueueT* thread_pool_public::get_queue(QueueIdT id) const noexcept
+	{
+		return id < this->m_datas_manager.m_queues_num.load(::std::memory_order_acquire) ? this->m_datas_manager.m_queues[id].get() : nullptr;
+	}
+
+	inline thread_pool_public::QueueT& thread_pool_public::ensure_default_queue_unchecked() noexcept
+	{
+		if (this->m_datas_manager.m_queues_num == 0)
+		{
+			this->m_datas_manager.m_queues[0].reset(new QueueT());
+			this->m_datas_manager.m_queues[0]->m_name = "default";
+			this->m_datas_manager.m_queues_num.store(1, ::std::memory_order_release);
+		}
+		return *this->m_datas_manager.m_queues[0];
+	}
+
+	inline bool thread_pool_public::is_fair() const noexcept
+	{
+		return this->m_datas_manager.m_queues_num.load(::std::memory_order_acquire) > 1;
+	}
+
+	inline thread_pool_public::TaskQueueT& thread_pool_public::get_task_queue(const QueueT* queue) noexcept
+	{
+		return (queue && queue->m_id != 0) ? const_cast<QueueT*>(queue)->m_tasks : this->m_datas_manager.m_tasks;
+	}
+
+	inline void thread_pool_public::enqueue_shared_unchecked(TaskT&& task) noexcept
+	{
+		if (!task.m_queue && this->is_fair())
+			task.m_queue = this->m_datas_manager.m_queues[0].get();
+		if (task.m_queue)
+			task.m_queue->m_submitted_num.fetch_add(1, ::std::memory_order_relaxed);
+		task.m_sequence = this->m_datas_manager.m_sequence++;
+		this->get_task_queue(task.m_queue).push(::std::move(task));
+	}
+
+	inline bool thread_pool_public::is_queue_ready(const QueueT& queue) noexcept
+	{
+		return !this->get_task_queue(&queue).empty() && !queue.is_saturated();
+	}
+
+	inline bool thread_pool_public::has_shared_task_unchecked() noexcept
+	{
+		if (!this->is_fair())
+			return !this->m_datas_manager.m_tasks.empty();
+
+		for (size_t i = 0; i < this->m_datas_manager.m_queues_num; ++i)
+		{
+			if (this->is_queue_ready(*this->m_datas_manager.m_queues[i]))
+				return true;
+		}
+		return false;
+	}
+
+	inline bool thread_pool_public::pop_fair_task_unchecked(TaskT& task) noexcept
+	{
+		DatasManagerT& datas = this->m_datas_manager;
+		const size_t num = datas.m_queues_num;
+		for (;;)
+		{
+			QueueT* target = nullptr;
+			size_t index = 0;
+			::int64_t rounds = INT64_MAX;
+			for (size_t i = 0; i < num; ++i)
+			{
+				index = (datas.m_queue_cursor + i) % num;
+				QueueT& queue = *datas.m_queues[index];
+				if (!this->is_queue_ready(queue))
+					continue;
+
+				const ::int64_t deficit = queue.m_deficit;
+				if (deficit > 0)
+				{
+					target = &queue;
+					break;
+				}
+				rounds = ::std::min(rounds, -deficit / queue.get_quantum() + 1);
+			}
+			if (!target)
+			{
+				if (rounds == INT64_MAX)
+					return false;
+
+				for (size_t i = 0; i < num; ++i)
+				{
+					QueueT& queue = *datas.m_queues[i];
+					if (this->is_queue_ready(queue))
+						queue.m_deficit += rounds * queue.get_quantum();
+				}
+				continue;
+			}
+
+			datas.m_queue_cursor = (index + 1) % num;
+			this->get_task_queue(target).pop(task);
+			if (this->claim_task(task))
+			{
+				task.m_queue = target;
+				++target->m_running_num;
+				++datas.m_running_num;
+				--datas.m_shared_num;
+				return true;
+			}
+			--datas.m_shared_num;
+			this->notify_discarded_unchecked();
+		}
+	}
+
+	inline void thread_pool_public::finish_queue_task(const TaskT& task, const TimePointT& begin_time, const TimePointT& end_time) noexcept
+	{
+		QueueT& queue = *task.m_queue;
+		const CounterT run_time = (CounterT)::std::chrono::duration_cast<::std::chrono::nanoseconds>(end_time - begin_time).count();
+		queue.m_deficit -= (::int64_t)run_time;
+		queue.m_busy_time.fetch_add(run_time, ::std::memory_order_relaxed);
+		queue.m_executed_num.fetch_add(1, ::std::memory_order_relaxed);
+#ifdef _HICXX_METRICS
+		if (task.m_enqueue_time != TimePointT{})
+			queue.m_wait_histogram.record((histogram::ValueT)::std::chrono::duration_cast<::std::chrono::nanoseconds>(begin_time - task.m_enqueue_time).count());
+#endif
+		if (queue.m_running_num-- == queue.m_max_running)
+			this->notify_idle();
+	}
+
+	inline void thread_pool_public::push_task_unchecked(TaskT&& task) noexcept
+	{
+		const TimePointT expiration_time = task.m_submit_on_expiration ? TimePointT::max() : task.m_expiration_time;
+		if (this->is_local_task(task))
+			this->push_local_task(::std::move(task));
+		else
+			this->push_shared_task_unchecked(::std::move(task));
+		this->schedule_purge(expiration_time);
+	}
+
+	inline bool thread_pool_public::push_task(TaskT&& task, const TimePointT& wait_time) noexcept
+	{
+		if (this->m_state_manager.m_bound.m_capacity != 0 && !this->admit_task(task, wait_time))
+			return false;
+		const TimePointT expiration_time = task.m_submit_on_expiration ? TimePointT::max() : task.m_expiration_time;
+		if (this->is_local_task(task))
+			this->push_local_task(::std::move(task));
+		else
+			this->push_shared_task(::std::move(task));
+		this->schedule_purge(expiration_time);
+		return true;
+	}
+
+	inline bool thread_pool_public::is_full_unchecked() const noexcept
+	{
+		const TaskNumT capacity = this->m_state_manager.m_bound.m_capacity;
+		return capacity != 0 && (TaskNumT)this->get_tasks_num_unchecked() >= capacity;
+	}
+
+	inline bool thread_pool_public::admit_task(TaskT& task, const TimePointT& wait_time) noexcept
+	{
+		if (!this->is_full_unchecked())
+			return true;
+
+		const OverflowPolicyT policy = this->m_state_manager.m_bound.m_policy;
+		if (policy == OverflowPolicyT::drop_oldest || policy == OverflowPolicyT::drop_lowest)
+		{
+			bool evicted = true;
+			{
+				UniqueLockT lock = this->m_state_manager.m_multi ? this->lock_tasks() : UniqueLockT{};
+				while (evicted && this->is_full_unchecked())
+					evicted = this->evict_task_unchecked(task, policy == OverflowPolicyT::drop_oldest);
+			}
+			this->resume_dropped();
+			if (evicted)
+				return true;
+		}
+
+		if (policy == OverflowPolicyT::block)
+		{
+			const ThreadPtrT ptr = get_current_worker();
+			if (wait_time == TimePointT::max() && ptr && ptr->m_pool == this)
+				return true;
+
+			if (wait_time > ClockT::now())
+			{
+				auto ready = [this]() { return this->m_state_manager.m_stopped || !this->is_full_unchecked(); };
+				UniqueLockT lock(this->m_mutex_manager.m_mutex);
+				++this->m_datas_manager.m_producer_num;
+				bool admitted = true;
+				if (wait_time == TimePointT::max())
+					this->m_mutex_manager.m_space_condition.wait(lock, ready);
+				else
+					admitted = this->m_mutex_manager.m_space_condition.wait_until(lock, wait_time, ready);
+				--this->m_datas_manager.m_producer_num;
+				if (admitted && !this->m_state_manager.m_stopped)
+					return true;
+			}
+		}
+		this->reject_task(task);
+		return false;
+	}
+
+	inline bool thread_pool_public::evict_task_unchecked(const TaskT& task, bool oldest) noexcept
+	{
+		DatasManagerT& datas = this->m_datas_manager;
+		TaskQueueT* victim = nullptr;
+		size_t victim_level = 0;
+		bool discarded = false;
+		const size_t num = ::std::max(datas.m_queues_num.load(), (size_t)1);
+		for (size_t i = 0; i < num; ++i)
+		{
+			TaskQueueT& tasks = i == 0 ? datas.m_tasks : datas.m_queues[i]->m_tasks;
+			size_t level = 0;
+			for (; tasks.m_bitmap != 0; discarded = true)
+			{
+				level = oldest ? tasks.get_oldest_level() : tasks.get_lowest_level();
+				const TaskRingT& ring = tasks.m_levels[level];
+				const TaskT& end = oldest ? ring.front() : ring.back();
+				if (!end.m_cancel || end.m_cancel->m_status.load() == CancelStatusT::queued)
+					break;
+
+				TaskT dead;
+				tasks.evict(level, oldest, dead);
+				--datas.m_shared_num;
+				this->drop_task(dead);
+			}
+			if (tasks.m_bitmap == 0)
+				continue;
+
+			if (victim)
+			{
+				const TaskRingT& ring = tasks.m_levels[level];
+				const TaskRingT& victim_ring = victim->m_levels[victim_level];
+				if (oldest ? (::int32_t)(ring.front().m_sequence - victim_ring.front().m_sequence) >= 0
+					: level > victim_level || (level == victim_level && (::int32_t)(ring.back().m_sequence - victim_ring.back().m_sequence) < 0))
+					continue;
+			}
+			victim = &tasks;
+			victim_level = level;
+		}
+		if (discarded)
+			this->notify_discarded_unchecked();
+		if (!victim || (!oldest && TaskQueueT::get_level(task.m_priority) <= victim_level))
+			return false;
+
+		TaskT evicted;
+		victim->evict(victim_level, oldest, evicted);
+		--datas.m_shared_num;
+		++datas.m_evicted_num;
+		evicted.m_function.reset();
+		this->drop_task(evicted);
+		return true;
+	}
+
+	inline void thread_pool_public::reject_task(TaskT& task) noexcept
+	{
+		++this->m_datas_manager.m_rejected_num;
+		task.m_function.reset();
+		this->drop_task(task);
+	}
+
+	inline void thread_pool_public::notify_space() noexcept
+	{
+		if (this->m_datas_manager.m_producer_num == 0)
+			return;
+
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+		}
+		this->m_mutex_manager.m_space_condition.notify_one();
+	}
+
+	inline void thread_pool_public::push_shared_task_unchecked(TaskT&& task) noexcept
+	{
+		this->stamp_task(task);
+		this->enqueue_shared_unchecked(::std::move(task));
+		const TaskNumT shared_num = ++this->m_datas_manager.m_shared_num;
+#ifdef _HICXX_METRICS
+		if (shared_num > this->m_datas_manager.m_peak_tasks_num.load(::std::memory_order_relaxed))
+			this->m_datas_manager.m_peak_tasks_num.store(shared_num, ::std::memory_order_relaxed);
+#else
+		(void)shared_num;
+#endif
+		this->m_mutex_manager.m_task_condition.notify_one();
+	}
+
+	inline void thread_pool_public::push_shared_task(TaskT&& task) noexcept
+	{
+		if (this->m_state_manager.m_multi)
+		{
+			UniqueLockT lock = this->lock_tasks();
+			this->push_shared_task_unchecked(::std::move(task));
+		}
+		else
+		{
+			this->push_shared_task_unchecked(::std::move(task));
+		}
+	}
+
+	inline void thread_pool_public::push_tasks_unchecked(TaskVectorT& tasks) noexcept
+	{
+		if (tasks.empty() || this->push_local_tasks(tasks))
+			return;
+
+		this->push_shared_tasks_unchecked(tasks);
+	}
+
+	inline void thread_pool_public::push_tasks(TaskVectorT& tasks) noexcept
+	{
+		if (this->m_state_manager.m_bound.m_capacity != 0)
+		{
+			for (TaskT& task : tasks)
+				this->push_task(::std::move(task));
+			return;
+		}
+		if (tasks.empty() || this->push_local_tasks(tasks))
+			return;
+
+		if (this->m_state_manager.m_multi)
+		{
+			UniqueLockT lock = this->lock_tasks();
+			this->push_shared_tasks_unchecked(tasks);
+		}
+		else
+		{
+			this->push_shared_tasks_unchecked(tasks);
+		}
+	}
+
+	inline void thread_pool_public::push_shared_tasks_unchecked(TaskVectorT& tasks) noexcept
+	{
+		this->stamp_tasks(tasks);
+		for (TaskT& task : tasks)
+			this->enqueue_shared_unchecked(::std::move(task));
+		const TaskNumT shared_num = this->m_datas_manager.m_shared_num += (TaskNumT)tasks.size();
+#ifdef _HICXX_METRICS
+		if (shared_num > this->m_datas_manager.m_peak_tasks_num.load(::std::memory_order_relaxed))
+			this->m_datas_manager.m_peak_tasks_num.store(shared_num, ::std::memory_order_relaxed);
+#else
+		(void)shared_num;
+#endif
+		this->notify_workers((TaskNumT)tasks.size());
+	}
+
+	inline bool thread_pool_public::push_local_tasks(TaskVectorT& tasks) noexcept
+	{
+		ThreadPtrT ptr = get_current_worker();
+		if (!ptr || ptr->m_pool != this || !this->is_local_task(tasks.front()))
+			return false;
+
+		this->stamp_tasks(tasks);
+		{
+			LockGuardT lock(ptr->m_local_mutex);
+			for (TaskT& task : tasks)
+				ptr->m_local_tasks.push_back(::std::move(task));
+			ptr->m_local_num += (TaskNumT)tasks.size();
+		}
+		this->m_datas_manager.m_local_num += (TaskNumT)tasks.size();
+		if (this->m_datas_manager.m_idle_num != 0)
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->notify_workers((TaskNumT)tasks.size());
+		}
+		return true;
+	}
+
+	inline void thread_pool_public::notify_workers(TaskNumT num) noexcept
+	{
+		const TaskNumT idle_num = (TaskNumT)this->m_datas_manager.m_idle_num;
+		if (num >= idle_num)
+		{
+			this->m_mutex_manager.m_task_condition.notify_all();
+			return;
+		}
+		for (TaskNumT i = 0; i < num; ++i)
+			this->m_mutex_manager.m_task_condition.notify_one();
+	}
+
+	inline void thread_pool_public::push_local_task(TaskT&& task) noexcept
+	{
+		ThreadPtrT ptr = get_current_worker();
+		if (!ptr || ptr->m_pool != this)
+		{
+			const bool numa = this->is_numa_aware();
+			const size_t node = numa ? this->m_datas_manager.m_topology.get_node_index(cpu_topology::get_current_cpu()) : 0;
+			ThreadPtrT target = nullptr;
+			ptr = this->m_datas_manager.m_submit_cursor;
+			const ThreadNumT threads_num = this->m_datas_manager.m_threads_num.load(::std::memory_order_relaxed);
+			for (ThreadNumT i = 0; i <= threads_num; ++i)
+			{
+				ptr = (ptr && ptr->m_next) ? ptr->m_next.load() : this->m_datas_manager.m_workers.load();
+				if (!ptr->m_enable.load(::std::memory_order_relaxed))
+					continue;
+				if (!target)
+					target = ptr;
+				if (!numa || ptr->m_node == node)
+				{
+					target = ptr;
+					break;
+				}
+			}
+			if (!target)
+			{
+				this->push_shared_task(::std::move(task));
+				return;
+			}
+			ptr = target;
+			this->m_datas_manager.m_submit_cursor = ptr;
+		}
+		this->stamp_task(task);
+		{
+			LockGuardT lock(ptr->m_local_mutex);
+			ptr->m_local_tasks.push_back(::std::move(task));
+			++ptr->m_local_num;
+		}
+		++this->m_datas_manager.m_local_num;
+		this->notify_idle();
+	}
+
+	inline bool thread_pool_public::pop_shared_task_unchecked(TaskT& task, bool urgent_only) noexcept
+	{
+		if (this->is_fair())
+			return !urgent_only && this->pop_fair_task_unchecked(task);
+
+		while (!this->m_datas_manager.m_tasks.empty())
+		{
+			if (urgent_only)
+			{
+				const TaskT& top = this->m_datas_manager.m_tasks.top();
+				if (top.m_priority <= 0 && !(this->m_datas_manager.m_tasks.m_edf && top.has_deadline()))
+					return false;
+			}
+
+			this->m_datas_manager.m_tasks.pop(task);
+			if (this->claim_task(task))
 			{
-				UniqueLockT lock(this->m_mutex_manager.m_mutex);
-				this->m_mutex_manager.m_task_condition.wait(lock);
+				if (task.m_queue)
+					++task.m_queue->m_running_num;
+				++this->m_datas_manager.m_running_num;
+				--this->m_datas_manager.m_shared_num;
+				return true;
+			}
+			--this->m_datas_manager.m_shared_num;
+			this->notify_discarded_unchecked();
+		}
+		return false;
+	}
+
+	inline bool thread_pool_public::pop_shared_task(TaskT& task, bool urgent_only) noexcept
+	{
+		if (this->m_datas_manager.m_shared_num == 0)
+			return false;
+
+		UniqueLockT lock = this->lock_tasks();
+		return this->pop_shared_task_unchecked(task, urgent_only);
+	}
+
+	inline bool thread_pool_public::pop_local_task(TaskT& task, ThreadPtrT ptr) noexcept
+	{
+		if (ptr->m_local_num == 0)
+			return false;
+
+		{
+			LockGuardT lock(ptr->m_local_mutex);
+			if (ptr->m_local_tasks.empty())
+				return false;
+
+			while (!ptr->m_local_tasks.empty())
+			{
+				task = ::std::move(ptr->m_local_tasks.back());
+				ptr->m_local_tasks.pop_back();
+				if (this->claim_task(task))
+				{
+					++this->m_datas_manager.m_running_num;
+					--ptr->m_local_num;
+					--this->m_datas_manager.m_local_num;
+					return true;
+				}
+				--ptr->m_local_num;
+				--this->m_datas_manager.m_local_num;
+			}
+		}
+		this->notify_discarded();
+		return false;
+	}
+
+	inline bool thread_pool_public::steal_task(TaskT& task, ThreadPtrT ptr) noexcept
+	{
+		if (this->m_datas_manager.m_local_num == 0)
+			return false;
+
+		if (ptr && this->is_numa_aware() && this->steal_task(task, ptr, true))
+			return true;
+		return this->steal_task(task, ptr, false);
+	}
+
+	inline bool thread_pool_public::steal_task(TaskT& task, ThreadPtrT ptr, bool same_node) noexcept
+	{
+		ThreadPtrT victim = ptr ? ptr->m_next.load() : nullptr;
+		bool discarded = false;
+		for (bool wrapped = false; ; victim = victim->m_next)
+		{
+			if (!victim)
+			{
+				if (wrapped)
+					break;
+				wrapped = true;
+				victim = this->m_datas_manager.m_workers;
+				if (!victim)
+					break;
+			}
+			if (victim == ptr)
+				break;
+			if (victim->m_local_num == 0 || (same_node && victim->m_node != ptr->m_node))
+				continue;
+
+			LockGuardT lock(victim->m_local_mutex);
+			while (!victim->m_local_tasks.empty())
+			{
+				task = ::std::move(victim->m_local_tasks.front());
+				victim->m_local_tasks.pop_front();
+				if (this->claim_task(task))
+				{
+#ifdef _HICXX_METRICS
+					MetricsT& metrics = this->get_metrics();
+					metrics.add(metrics.m_stolen_num, 1);
+#endif
+					++this->m_datas_manager.m_running_num;
+					--victim->m_local_num;
+					--this->m_datas_manager.m_local_num;
+					return true;
+				}
+				--victim->m_local_num;
+				--this->m_datas_manager.m_local_num;
+				discarded = true;
+			}
+		}
+		if (discarded)
+			this->notify_discarded();
+		return false;
+	}
+
+	inline bool thread_pool_public::is_numa_aware() const noexcept
+	{
+		return this->m_state_manager.m_placement != PlacementT::none && this->m_datas_manager.m_topology.get_nodes_num() > 1;
+	}
+
+	inline void thread_pool_public::flush_local_tasks(ThreadPtrT ptr) noexcept
+	{
+		TaskDequeT tasks;
+		{
+			LockGuardT local_lock(ptr->m_local_mutex);
+			if (ptr->m_local_tasks.empty())
+				return;
+
+			tasks.swap(ptr->m_local_tasks);
+			ptr->m_local_num = 0;
+		}
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			for (TaskT& task : tasks)
+				this->enqueue_shared_unchecked(::std::move(task));
+			this->m_datas_manager.m_shared_num += (TaskNumT)tasks.size();
+		}
+		this->m_datas_manager.m_local_num -= (TaskNumT)tasks.size();
+		this->m_mutex_manager.m_task_condition.notify_all();
+	}
+
+	inline void thread_pool_public::retire_worker(ThreadPtrT ptr) noexcept
+	{
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			this->m_datas_manager.m_threads.erase(::std::this_thread::get_id());
+			ptr->m_enable = false;
+			this->m_datas_manager.m_retired_counters.merge(ptr->m_counters);
+			ptr->m_counters.clear();
+#ifdef _HICXX_METRICS
+			this->m_datas_manager.m_retired_metrics.merge(ptr->m_metrics);
+			ptr->m_metrics.clear();
+#endif
+		}
+		this->flush_local_tasks(ptr);
+	}
+
+	inline void thread_pool_public::join_workers() noexcept
+	{
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+		{
+			if (ptr->m_exited.load(::std::memory_order_acquire) && ptr->m_thread.joinable())
+				ptr->m_thread.join();
+		}
+	}
+
+	inline thread_pool_public::ThreadPtrT thread_pool_public::revive_worker() noexcept
+	{
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+		{
+			if (!ptr->m_enable.load(::std::memory_order_relaxed) && !ptr->m_thread.joinable())
+			{
+				ptr->m_exited.store(false, ::std::memory_order_relaxed);
+				return ptr;
+			}
+		}
+		return nullptr;
+	}
+
+	inline void thread_pool_public::notify_idle() noexcept
+	{
+		if (this->m_datas_manager.m_idle_num == 0)
+			return;
+
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+		}
+		this->m_mutex_manager.m_task_condition.notify_one();
+	}
+
+	inline void thread_pool_public::notify_discarded_unchecked() noexcept
+	{
+		if (this->m_datas_manager.m_waiter_num != 0 && this->is_all_done_unchecked())
+			this->m_mutex_manager.m_wait_condition.notify_all();
+	}
+
+	inline void thread_pool_public::notify_discarded() noexcept
+	{
+		if (this->is_all_done_unchecked())
+			this->notify_done();
+	}
+
+	inline void thread_pool_public::notify_done() noexcept
+	{
+		if (this->m_datas_manager.m_waiter_num == 0)
+			return;
+
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+		}
+		this->m_mutex_manager.m_wait_condition.notify_all();
+	}
+
+	inline thread_pool_public::ThreadPtrT& thread_pool_public::get_current_worker() noexcept
+	{
+		static thread_local ThreadPtrT ptr = nullptr;
+		return ptr;
+	}
+
+	inline void thread_pool_public::notify_state() noexcept
+	{
+		{
+			LockGuardT lock(this->m_mutex_manager.m_state_mutex);
+		}
+		this->m_mutex_manager.m_state_condition.notify_all();
+	}
+
+	inline void thread_pool_public::wait_running_done() noexcept
+	{
+		UniqueLockT lock(this->m_mutex_manager.m_state_mutex);
+		this->m_mutex_manager.m_state_condition.wait(lock, [this]() { return this->m_datas_manager.m_running_num == 0; });
+	}
+
+	inline void thread_pool_public::wait_threads_deleted() noexcept
+	{
+		UniqueLockT lock(this->m_mutex_manager.m_state_mutex);
+		this->m_mutex_manager.m_state_condition.wait(lock, [this]()
+			{
+				return this->m_state_manager.m_stopped || this->m_datas_manager.m_delete_num <= 0;
+			});
+	}
+
+	inline bool thread_pool_public::is_expired(const TaskT& task, const TimePointT& now) noexcept
+	{
+		return !task.m_submit_on_expiration && now > task.m_expiration_time;
+	}
+
+	inline thread_pool_public::TimerIdT thread_pool_public::insert_timer_unchecked(const TimePointT& time, const DurationT& period, TimerT&& timer) noexcept
+	{
+		if (this->m_state_manager.m_timer_stopped)
+			return TimerIdT{};
+
+		if (!this->m_datas_manager.m_timer_thread.joinable())
+			this->m_datas_manager.m_timer_thread = ThreadT{ &thread_pool_public::timer_mission, this };
+		const TimerIdT id = this->m_datas_manager.m_timers.insert(time, period, ::std::move(timer));
+		if (time < this->m_datas_manager.m_timer_wake_time)
+		{
+			this->m_datas_manager.m_timer_wake_time = time;
+			this->m_mutex_manager.m_timer_condition.notify_one();
+		}
+		return id;
+	}
+
+	inline thread_pool_public::TimerIdT thread_pool_public::insert_timer(const TimePointT& time, const DurationT& period, TimerT&& timer) noexcept
+	{
+		LockGuardT lock(this->m_mutex_manager.m_timer_mutex);
+		return this->insert_timer_unchecked(time, period, ::std::move(timer));
+	}
+
+	inline void thread_pool_public::rearm_timer(TimerIdT id, const DurationT& period) noexcept
+	{
+		const TimePointT time = ClockT::now() + period;
+		LockGuardT lock(this->m_mutex_manager.m_timer_mutex);
+		if (this->m_datas_manager.m_timers.rearm(id, time) && time < this->m_datas_manager.m_timer_wake_time)
+		{
+			this->m_datas_manager.m_timer_wake_time = time;
+			this->m_mutex_manager.m_timer_condition.notify_one();
+		}
+	}
+
+	inline void thread_pool_public::schedule_purge(const TimePointT& expiration_time) noexcept
+	{
+		DatasManagerT& datas = this->m_datas_manager;
+		if (expiration_time >= datas.m_purge_time.load())
+			return;
+
+		LockGuardT lock(this->m_mutex_manager.m_timer_mutex);
+		if (expiration_time >= datas.m_purge_time.load())
+			return;
+
+		if (datas.m_purge_timer.valid())
+			datas.m_timers.cancel(datas.m_purge_timer);
+		datas.m_purge_timer = this->insert_timer_unchecked(expiration_time + DurationT(1), DurationT::zero(), TimerT{ {}, nullptr, 0, TimerModeT::purge });
+		if (datas.m_purge_timer.valid())
+			datas.m_purge_time.store(expiration_time);
+	}
+
+	inline void thread_pool_public::purge_expired() noexcept
+	{
+		const TimePointT now = ClockT::now();
+		TimePointT earliest = TimePointT::max();
+		{
+			LockGuardT lock(this->m_mutex_manager.m_mutex);
+			TaskNumT removed = (TaskNumT)this->m_datas_manager.m_tasks.purge(now, earliest);
+			for (size_t i = 1; i < this->m_datas_manager.m_queues_num; ++i)
+				removed += (TaskNumT)this->m_datas_manager.m_queues[i]->m_tasks.purge(now, earliest);
+			this->m_datas_manager.m_shared_num -= removed;
+			this->m_datas_manager.m_counters.m_dropped_num += removed;
+		}
+		for (ThreadPtrT ptr = this->m_datas_manager.m_workers; ptr; ptr = ptr->m_next)
+		{
+			if (ptr->m_local_num == 0)
+				continue;
+
+			LockGuardT lock(ptr->m_local_mutex);
+			const size_t size = ptr->m_local_tasks.size();
+			ptr->m_local_tasks.erase(::std::remove_if(ptr->m_local_tasks.begin(), ptr->m_local_tasks.end(),
+				[&now](const TaskT& task) { return is_expired(task, now); }), ptr->m_local_tasks.end());
+			const TaskNumT removed = (TaskNumT)(size - ptr->m_local_tasks.size());
+			ptr->m_local_num -= removed;
+			this->m_datas_manager.m_local_num -= removed;
+			this->m_datas_manager.m_counters.m_dropped_num += removed;
+			for (const TaskT& task : ptr->m_local_tasks)
+			{
+				if (!task.m_submit_on_expiration && task.m_expiration_time < earliest)
+					earliest = task.m_expiration_time;
+			}
+		}
+		this->schedule_purge(earliest);
+		if (this->m_datas_manager.m_producer_num != 0)
+		{
+			{
+				LockGuardT lock(this->m_mutex_manager.m_mutex);
+			}
+			this->m_mutex_manager.m_space_condition.notify_all();
+		}
+		if (this->is_all_done_unchecked())
+			this->notify_done();
+	}
+
+	inline thread_pool_public::TimerActionT thread_pool_public::fire_timer(TimerIdT id, TimerT& timer, TaskVectorT& tasks, bool& purge, bool& scale) noexcept
+	{
+		switch (timer.m_mode)
+		{
+		case TimerModeT::once:
+			tasks.push_back({ ::std::move(timer.m_function), TimePointT{}, timer.m_priority, true });
+			return TimerActionT::release;
+		case TimerModeT::fixed_rate:
+			tasks.push_back({ [periodic = timer.m_periodic]() { (*periodic)(); }, TimePointT{}, timer.m_priority, true });
+			return TimerActionT::rearm;
+		case TimerModeT::fixed_delay:
+			tasks.push_back({ [this, id, periodic = timer.m_periodic, period = this->m_datas_manager.m_timers.get_period(id)]()
+				{
+					try
+					{
+						(*periodic)();
+					}
+					catch (...)
+					{
+						this->rearm_timer(id, period);
+						throw;
+					}
+					this->rearm_timer(id, period);
+				}, TimePointT{}, timer.m_priority, true });
+			return TimerActionT::detach;
+		case TimerModeT::autoscale:
+			scale = true;
+			return TimerActionT::rearm;
+		default:
+			this->m_datas_manager.m_purge_timer = TimerIdT{};
+			this->m_datas_manager.m_purge_time.store(TimePointT::max());
+			purge = true;
+			return TimerActionT::release;
+		}
+	}
+
+	inline void thread_pool_public::timer_mission() noexcept
+	{
+		TaskVectorT tasks;
+		UniqueLockT lock(this->m_mutex_manager.m_timer_mutex);
+		while (!this->m_state_manager.m_timer_stopped)
+		{
+			bool purge = false;
+			bool scale = false;
+			this->m_datas_manager.m_timers.advance(ClockT::now(), [this, &tasks, &purge, &scale](TimerIdT id, TimerT& timer)
+				{
+					return this->fire_timer(id, timer, tasks, purge, scale);
+				});
+			if (!tasks.empty() || purge || scale)
+			{
+				lock.unlock();
+				if (!tasks.empty())
+				{
+					LockGuardT task_lock(this->m_mutex_manager.m_mutex);
+					this->push_shared_tasks_unchecked(tasks);
+				}
+				tasks.clear();
+				if (purge)
+					this->purge_expired();
+				if (scale)
+					this->autoscale();
+				lock.lock();
+				continue;
+			}
+
+			this->m_datas_manager.m_timer_wake_time = this->m_datas_manager.m_timers.get_next_time();
+			if (this->m_datas_manager.m_timer_wake_time == TimePointT::max())
+				this->m_mutex_manager.m_timer_condition.wait(lock);
+			else
+				this->m_mutex_manager.m_timer_condition.wait_until(lock, this->m_datas_manager.m_timer_wake_time);
+		}
+	}
+
+	inline void thread_pool_public::arm_autoscale() noexcept
+	{
+		const AutoscaleT& autoscale = this->m_state_manager.m_autoscale;
+		if (!autoscale.m_enable || this->m_datas_manager.m_autoscale_timer.valid())
+			return;
+
+		this->m_datas_manager.m_autoscale_done_num = this->get_done_num();
+		this->m_datas_manager.m_grow_samples = 0;
+		this->m_datas_manager.m_shrink_samples = 0;
+		this->m_datas_manager.m_autoscale_timer = this->insert_timer(ClockT::now() + autoscale.m_interval, autoscale.m_interval,
+			TimerT{ {}, nullptr, 0, TimerModeT::autoscale });
+	}
+
+	inline void thread_pool_public::autoscale() noexcept
+	{
+		LockGuardT lock(this->m_mutex_manager.m_mutex);
+		const AutoscaleT& autoscale = this->m_state_manager.m_autoscale;
+		if (!autoscale.m_enable || this->m_state_manager.m_stopped || this->m_state_manager.m_pausing)
+			return;
+
+		DatasManagerT& datas = this->m_datas_manager;
+		const CounterT done_num = this->get_done_num();
+		const CounterT done_delta = done_num - datas.m_autoscale_done_num;
+		datas.m_autoscale_done_num = done_num;
+
+		const ThreadNumT threads_num = datas.m_threads_num;
+		const ThreadNumT tasks_num = this->get_tasks_num_unchecked();
+		const ThreadNumT busy_num = ::std::max(threads_num - (ThreadNumT)datas.m_idle_num, (ThreadNumT)0);
+		const double utilisation = threads_num > 0 ? (double)busy_num / (double)threads_num : 1.0;
+		const DurationT wait = tasks_num == 0 ? DurationT::zero()
+			: done_delta == 0 ? DurationT::max()
+			: ::std::chrono::duration_cast<DurationT>(autoscale.m_interval * ((double)tasks_num / (double)done_delta));
+
+		const bool grow = wait > autoscale.m_grow_wait && utilisation >= autoscale.m_grow_utilisation;
+		const bool shrink = tasks_num == 0 && utilisation <= autoscale.m_shrink_utilisation;
+		datas.m_grow_samples = grow ? datas.m_grow_samples + 1 : 0;
+		datas.m_shrink_samples = shrink ? datas.m_shrink_samples + 1 : 0;
+
+		ThreadNumT target = ::std::min(::std::max(threads_num, autoscale.m_min_num), autoscale.m_max_num);
+		if (datas.m_grow_samples >= autoscale.m_grow_samples)
+		{
+			target = ::std::min(target + autoscale.m_step, autoscale.m_max_num);
+			datas.m_grow_samples = 0;
+		}
+		else if (datas.m_shrink_samples >= autoscale.m_shrink_samples)
+		{
+			target = ::std::max(target - autoscale.m_step, autoscale.m_min_num);
+			datas.m_shrink_samples = 0;
+		}
+		if (target != threads_num)
+			this->set_threads_num_no_wait_unchecked(target);
+	}
+
+	inline void thread_pool_public::stop_timer() noexcept
+	{
+		{
+			LockGuardT lock(this->m_mutex_manager.m_timer_mutex);
+			this->m_state_manager.m_timer_stopped = true;
+			this->m_datas_manager.m_timers.clear();
+			this->m_datas_manager.m_purge_timer = TimerIdT{};
+			this->m_datas_manager.m_purge_time.store(TimePointT::max());
+		}
+		this->m_mutex_manager.m_timer_condition.notify_all();
+		if (this->m_datas_manager.m_timer_thread.joinable())
+			this->m_datas_manager.m_timer_thread.join();
+	}
+
+	inline bool thread_pool_public::has_work() const noexcept
+	{
+		return this->m_state_manager.m_stopped.load(::std::memory_order_relaxed) || this->m_state_manager.m_pausing.load(::std::memory_order_relaxed) || (this->m_datas_manager.m_delete_num > 0)
+			|| (this->m_datas_manager.m_shared_num != 0) || (this->m_datas_manager.m_local_num != 0);
+	}
+
+	inline bool thread_pool_public::spin_for_task() const noexcept
+	{
+		const IdlePolicyT idle_policy = this->m_state_manager.m_idle_policy;
+		for (::uint32_t i = 0; i < idle_policy.m_spin_num; ++i)
+		{
+			if (this->has_work())
+				return true;
+			_HICXX_PAUSE();
+		}
+		for (::uint32_t i = 0; i < idle_policy.m_yield_num; ++i)
+		{
+			if (this->has_work())
+				return true;
+			::std::this_thread::yield();
+		}
+		return false;
+	}
+
+	inline bool thread_pool_public::get_task(TaskT& task) noexcept
+	{
+		return this->get_task(task, nullptr);
+	}
+
+	inline bool thread_pool_public::get_task(TaskT& task, ThreadPtrT ptr) noexcept
+	{
+		while (!this->m_state_manager.m_stopped.load(::std::memory_order_relaxed) && !this->m_state_manager.m_pausing.load(::std::memory_order_relaxed) && this->m_datas_manager.m_delete_num <= 0)
+		{
+			if (this->pop_shared_task(task, true))
+				return true;
+			if (ptr && this->pop_local_task(task, ptr))
+				return true;
+			if (this->steal_task(task, ptr))
+				return true;
+			if (this->spin_for_task() && this->pop_shared_task(task, false))
+				return true;
+
+			UniqueLockT lock = this->lock_tasks();
+			++this->m_datas_manager.m_idle_num;
+			this->m_mutex_manager.m_task_condition.wait(lock, [this, ptr]()
+				{
+					return this->m_state_manager.m_stopped || this->m_state_manager.m_pausing || this->has_shared_task_unchecked()
+						|| (this->m_datas_manager.m_local_num != 0) || (this->m_datas_manager.m_delete_num > 0);
+				});
+			--this->m_datas_manager.m_idle_num;
+
+			if (this->m_state_manager.m_stopped.load(::std::memory_order_relaxed) || this->m_state_manager.m_pausing.load(::std::memory_order_relaxed) || this->m_datas_manager.m_delete_num > 0)
+				return false;
+			if (this->pop_shared_task_unchecked(task, false))
+				return true;
+		}
+		return false;
+	}
+
+	inline void thread_pool_public::run_task(TaskT& task) noexcept
+	{
+		this->notify_space();
+#ifdef _HICXX_TASK_TIMESTAMP
+		const TimePointT begin_time = ClockT::now();
+#else
+		const TimePointT begin_time = task.m_queue ? ClockT::now() : TimePointT{};
+#endif
+#ifdef _HICXX_METRICS
+		MetricsT& metrics = this->get_metrics();
+		if (task.m_enqueue_time != TimePointT{})
+			metrics.record(metrics.m_wait_histogram, (histogram::ValueT)::std::chrono::duration_cast<::std::chrono::nanoseconds>(begin_time - task.m_enqueue_time).count());
+#endif
+		bool run = true;
+		if (task.has_deadline())
+		{
+			const bool in_time = ClockT::now() <= task.m_expiration_time;
+			run = in_time || task.m_submit_on_expiration;
+			CountersT& counters = this->get_counters();
+			counters.add(in_time ? counters.m_met_num : run ? counters.m_late_num : counters.m_dropped_num, 1);
+		}
+
+		CancelStateT*& current_cancel = get_current_cancel();
+		CancelStateT* const outer_cancel = current_cancel;
+		current_cancel = task.m_cancel.get();
+		if (run && this->m_state_manager.m_try_mode)
+		{
+			try
+			{
+				task.m_function();
+			}
+			catch (const ::std::exception& exception)
+			{
+				this->report_exception(exception.what());
+			}
+			catch (...)
+			{
+				this->report_exception("unknown exception");
+			}
+		}
+		else if (run)
+		{
+			task.m_function();
+		}
+		task.m_function.reset();
+		current_cancel = outer_cancel;
+		if (task.m_cancel)
+		{
+			task.m_cancel->m_status.store(CancelStatusT::finished);
+			task.m_cancel.reset();
+		}
+#ifdef _HICXX_TASK_TIMESTAMP
+		const TimePointT end_time = ClockT::now();
+#else
+		const TimePointT end_time = task.m_queue ? ClockT::now() : TimePointT{};
+#endif
+		if (task.m_queue)
+			this->finish_queue_task(task, begin_time, end_time);
+#ifdef _HICXX_TRACE
+		if (this->m_state_manager.m_tracing)
+			this->record_trace(task, begin_time, end_time);
+#endif
+#ifdef _HICXX_METRICS
+		const CounterT run_time = (CounterT)::std::chrono::duration_cast<::std::chrono::nanoseconds>(end_time - begin_time).count();
+		metrics.record(metrics.m_run_histogram, run_time);
+		metrics.add(metrics.m_busy_time, run_time);
+		metrics.add(metrics.m_executed_num, 1);
+#endif
+		if (this->m_state_manager.m_autoscale.m_enable)
+		{
+			CountersT& counters = this->get_counters();
+			counters.add(counters.m_done_num, 1);
+		}
+		if (--this->m_datas_manager.m_running_num != 0)
+			return;
+		if (this->m_state_manager.m_pausing || this->m_state_manager.m_stopped)
+			this->notify_state();
+		if (this->get_tasks_num_unchecked() == 0)
+			this->notify_done();
+	}
+
+	inline bool thread_pool_public::run_one() noexcept
+	{
+		ThreadPtrT ptr = get_current_worker();
+		if (ptr && ptr->m_pool != this)
+			ptr = nullptr;
+
+		TaskT task;
+		if (this->pop_shared_task(task, true) || (ptr && this->pop_local_task(task, ptr)) || this->steal_task(task, ptr) || this->pop_shared_task(task, false))
+		{
+			this->run_task(task);
+			return true;
+		}
+		return false;
+	}
+
+	inline bool thread_pool_public::is_hungry() const noexcept
+	{
+		if (this->m_datas_manager.m_idle_num > 0)
+			return true;
+
+		ThreadPtrT ptr = get_current_worker();
+		return this->m_state_manager.m_stealing.load(::std::memory_order_relaxed) && ptr && (ptr->m_pool == this) && (ptr->m_local_num == 0);
+	}
+
+	inline void thread_pool_public::mission(ThreadPtrT ptr) noexcept
+	{
+		get_current_worker() = ptr;
+		if (ptr->m_cpu != cpu_topology::npos)
+			cpu_topology::pin_current_thread(ptr->m_cpu);
+		TaskT task;
+		while (!this->m_state_manager.m_stopped.load(::std::memory_order_relaxed))
+		{
+			{
+				ThreadNumT delete_num = this->m_datas_manager.m_delete_num;
+				while (delete_num > 0 && !this->m_datas_manager.m_delete_num.compare_exchange_weak(delete_num, delete_num - 1));
+				if (delete_num > 0)
+				{
+					this->retire_worker(ptr);
+					if (delete_num == 1)
+						this->notify_state();
+					ptr->m_exited.store(true, ::std::memory_order_release);
+					return;
+				}
+				if (this->m_state_manager.m_pausing.load(::std::memory_order_relaxed))
+				{
+					UniqueLockT lock(this->m_mutex_manager.m_mutex);
+					m_mutex_manager.m_pause_condition.wait(lock, [this]()
+						{
+							return this->m_state_manager.m_stopped || !this->m_state_manager.m_pausing || (this->m_datas_manager.m_delete_num > 0);
+						});
+				}
 			}
+			if (this->get_task(task, ptr))
+				this->run_task(task);
 		}
+		ptr->m_exited.store(true, ::std::memory_order_release);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,116 @@
+/**
+ * @file	timing_wheel.h
+ * @brief	HiCxx ʱģ
+ * @author	
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace HiCxx
+{
+	/**
+	 * @brief	ֲʱ
+	 * @note	 levels_num , ÿ slots_num ,  n һ۸ slots_num^n ̶;
+	 *			ڵв±괮˫, ȡΪ O(1), ͷŵĽڵ;
+	 *			ÿλͼ¼ǿղ, ƽʱֱһнڵĿ̶
+	*/
+	template<class _TValue> class timing_wheel
+	{
+	public:
+		using ValueT		= _TValue;
+		using ClockT		= ::std::chrono::steady_clock;
+		using TimePointT	= ClockT::time_point;
+		using DurationT		= ClockT::duration;
+		using TickT			= ::uint64_t;
+		using IndexT		= ::uint32_t;
+		using SlotBitmapT	= ::uint64_t;
+		static constexpr size_t levels_num	= 4;
+		static constexpr size_t slots_bits	= 6;
+		static constexpr size_t slots_num	= (size_t)1 << slots_bits;
+		static constexpr IndexT npos		= (IndexT)-1;
+
+		/**
+		 * @brief	ڵľ, ڵͷźı, ɾ֮ʧЧ
+		*/
+		struct IdT
+		{
+			IndexT			m_index = npos;
+			IndexT			m_generation = 0;
+
+			bool valid() const noexcept;
+		};
+		/**
+		 * @brief	ڻصķֵ
+		 * @note	release ͷŽڵ; rearm ¹; detach ڵ㵫, ֮ rearm ¹
+		*/
+		enum class ActionT : ::uint8_t
+		{
+			release,
+			rearm,
+			detach
+		};
+		enum class StateT : ::uint8_t
+		{
+			free,
+			linked,
+			detached
+		};
+		struct NodeT
+		{
+			ValueT			m_value;
+			TimePointT		m_time;
+			DurationT		m_period = DurationT::zero();
+			IndexT			m_prev = npos;
+			IndexT			m_next = npos;
+			IndexT			m_generation = 0;
+			StateT			m_state = StateT::free;
+			::uint8_t		m_level = 0;
+			::uint8_t		m_slot = 0;
+		};
+		struct LevelT
+		{
+			IndexT			m_heads[slots_num];
+			SlotBitmapT		m_bitmap = 0;
+
+			LevelT() noexcept;
+		};
+		using NodeVectorT	= ::std::vector<NodeT>;
+
+		explicit timing_wheel(DurationT tick = ::std::chrono::milliseconds(1)) noexcept;
+
+		IdT insert(const TimePointT& time, const DurationT& period, ValueT&& value) noexcept;
+		bool cancel(IdT id) noexcept;
+		bool rearm(IdT id, const TimePointT& time) noexcept;
+		template<class _TFunc>
+		void advance(const TimePointT& now, _TFunc&& fire) noexcept;
+		TimePointT get_next_time() const noexcept;
+		bool contains(IdT id) const noexcept;
+		DurationT get_period(IdT id) const noexcept;
+		size_t size() const noexcept;
+		bool empty() const noexcept;
+		void clear() noexcept;
+
+	protected:
+		static size_t get_lowest_slot(SlotBitmapT bitmap) noexcept;
+		TickT get_tick(const TimePointT& time) const noexcept;
+		TickT get_next_tick() const noexcept;
+		IndexT allocate() noexcept;
+		void release(IndexT index) noexcept;
+		bool link(IndexT index) noexcept;
+		void unlink(IndexT index) noexcept;
+		template<class _TFunc>
+		void fire(IndexT index, _TFunc& fire) noexcept;
+
+		DurationT		m_tick;
+		TimePointT		m_start;
+		TickT			m_current_tick = 0;
+		NodeVectorT		m_nodes;
+		IndexT			m_free_head = npos;
+		size_t			m_size = 0;
+		LevelT			m_levels[levels_num];
+	};
+}
@@ -0,0 +1,309 @@
+/**
+ * @file	timing_wheel.inl
+ * @brief	HiCxx ʱģ
+ * @author	
+*/
+
+#include "timing_wheel.h"
+
+namespace HiCxx
+{
+	template<class _TValue>
+	inline bool timing_wheel<_TValue>::IdT::valid() const noexcept
+	{
+		return this->m_index != npos;
+	}
+
+	template<class _TValue>
+	inline timing_wheel<_TValue>::LevelT::LevelT() noexcept
+	{
+		for (IndexT& head : this->m_heads)
+			head = npos;
+	}
+
+	template<class _TValue>
+	inline timing_wheel<_TValue>::timing_wheel(DurationT tick) noexcept
+		: m_tick(tick), m_start(ClockT::now())
+	{
+	}
+
+	template<class _TValue>
+	inline typename timing_wheel<_TValue>::IdT timing_wheel<_TValue>::insert(const TimePointT& time, const DurationT& period, ValueT&& value) noexcept
+	{
+		const IndexT index = this->allocate();
+		NodeT& node = this->m_nodes[index];
+		node.m_value = ::std::move(value);
+		node.m_time = time;
+		node.m_period = period;
+		this->link(index);
+		return IdT{ index, node.m_generation };
+	}
+
+	template<class _TValue>
+	inline bool timing_wheel<_TValue>::cancel(IdT id) noexcept
+	{
+		if (!this->contains(id))
+			return false;
+
+		if (this->m_nodes[id.m_index].m_state == StateT::linked)
+			this->unlink(id.m_index);
+		this->release(id.m_index);
+		return true;
+	}
+
+	template<class _TValue>
+	inline bool timing_wheel<_TValue>::rearm(IdT id, const TimePointT& time) noexcept
+	{
+		if (!this->contains(id) || this->m_nodes[id.m_index].m_state != StateT::detached)
+			return false;
+
+		this->m_nodes[id.m_index].m_time = time;
+		this->link(id.m_index);
+		return true;
+	}
+
+	template<class _TValue>
+	template<class _TFunc>
+	inline void timing_wheel<_TValue>::advance(const TimePointT& now, _TFunc&& fire) noexcept
+	{
+		const TickT target = now > this->m_start ? (TickT)((now - this->m_start) / this->m_tick) : 0;
+		while (true)
+		{
+			const TickT tick = this->get_next_tick();
+			if (tick > target)
+				break;
+
+			this->m_current_tick = tick;
+			for (size_t level = levels_num - 1; level > 0; --level)
+			{
+				if (tick & (((TickT)1 << (slots_bits * level)) - 1))
+					continue;
+
+				const size_t slot = (size_t)(tick >> (slots_bits * level)) & (slots_num - 1);
+				LevelT& wheel = this->m_levels[level];
+				IndexT index = wheel.m_heads[slot];
+				wheel.m_heads[slot] = npos;
+				wheel.m_bitmap &= ~((SlotBitmapT)1 << slot);
+				while (index != npos)
+				{
+					const IndexT next = this->m_nodes[index].m_next;
+					if (this->get_tick(this->m_nodes[index].m_time) <= tick)
+						this->fire(index, fire);
+					else
+						this->link(index);
+					index = next;
+				}
+			}
+
+			const size_t slot = (size_t)tick & (slots_num - 1);
+			LevelT& wheel = this->m_levels[0];
+			IndexT index = wheel.m_heads[slot];
+			wheel.m_heads[slot] = npos;
+			wheel.m_bitmap &= ~((SlotBitmapT)1 << slot);
+			while (index != npos)
+			{
+				const IndexT next = this->m_nodes[index].m_next;
+				this->fire(index, fire);
+				index = next;
+			}
+		}
+		if (target > this->m_current_tick)
+			this->m_current_tick = target;
+	}
+
+	template<class _TValue>
+	inline typename timing_wheel<_TValue>::TimePointT timing_wheel<_TValue>::get_next_time() const noexcept
+	{
+		const TickT tick = this->get_next_tick();
+		if (tick == (TickT)-1)
+			return TimePointT::max();
+		return this->m_start + this->m_tick * (typename DurationT::rep)tick;
+	}
+
+	template<class _TValue>
+	inline bool timing_wheel<_TValue>::contains(IdT id) const noexcept
+	{
+		return id.m_index < this->m_nodes.size() && this->m_nodes[id.m_index].m_generation == id.m_generation
+			&& this->m_nodes[id.m_index].m_state != StateT::free;
+	}
+
+	template<class _TValue>
+	inline typename timing_wheel<_TValue>::DurationT timing_wheel<_TValue>::get_period(IdT id) const noexcept
+	{
+		return this->contains(id) ? this->m_nodes[id.m_index].m_period : DurationT::zero();
+	}
+
+	template<class _TValue>
+	inline size_t timing_wheel<_TValue>::size() const noexcept
+	{
+		return this->m_size;
+	}
+
+	template<class _TValue>
+	inline bool timing_wheel<_TValue>::empty() const noexcept
+	{
+		return this->m_size == 0;
+	}
+
+	template<class _TValue>
+	inline void timing_wheel<_TValue>::clear() noexcept
+	{
+		for (IndexT index = 0; index < (IndexT)this->m_nodes.size(); ++index)
+			if (this->m_nodes[index].m_state != StateT::free)
+				this->release(index);
+		for (LevelT& wheel : this->m_levels)
+			wheel = LevelT{};
+	}
+
+	template<class _TValue>
+	inline size_t timing_wheel<_TValue>::get_lowest_slot(SlotBitmapT bitmap) noexcept
+	{
+#if defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanForward64(&index, bitmap);
+		return (size_t)index;
+#elif defined(__GNUC__)
+		return (size_t)__builtin_ctzll(bitmap);
+#else
+		size_t index = 0;
+		while (!(bitmap & 1))
+		{
+			bitmap >>= 1;
+			++index;
+		}
+		return index;
+#endif
+	}
+
+	template<class _TValue>
+	inline typename timing_wheel<_TValue>::TickT timing_wheel<_TValue>::get_tick(const TimePointT& time) const noexcept
+	{
+		if (time <= this->m_start)
+			return 0;
+		const DurationT offset = time - this->m_start;
+		return (TickT)((offset + this->m_tick - DurationT(1)) / this->m_tick);
+	}
+
+	template<class _TValue>
+	inline typename timing_wheel<_TValue>::TickT timing_wheel<_TValue>::get_next_tick() const noexcept
+	{
+		TickT result = (TickT)-1;
+		for (size_t level = 0; level < levels_num; ++level)
+		{
+			const SlotBitmapT bitmap = this->m_levels[level].m_bitmap;
+			if (!bitmap)
+				continue;
+
+			const size_t shift = slots_bits * level;
+			const size_t current = (size_t)(this->m_current_tick >> shift) & (slots_num - 1);
+			const SlotBitmapT ahead = current == slots_num - 1 ? 0 : bitmap & (~(SlotBitmapT)0 << (current + 1));
+			const size_t distance = ahead ? get_lowest_slot(ahead) - current : get_lowest_slot(bitmap) + slots_num - current;
+			const TickT tick = ((this->m_current_tick >> shift) + distance) << shift;
+			if (tick < result)
+				result = tick;
+		}
+		return result;
+	}
+
+	template<class _TValue>
+	inline typename timing_wheel<_TValue>::IndexT timing_wheel<_TValue>::allocate() noexcept
+	{
+		IndexT index = this->m_free_head;
+		if (index != npos)
+		{
+			this->m_free_head = this->m_nodes[index].m_next;
+		}
+		else
+		{
+			index = (IndexT)this->m_nodes.size();
+			this->m_nodes.emplace_back();
+		}
+		++this->m_size;
+		return index;
+	}
+
+	template<class _TValue>
+	inline void timing_wheel<_TValue>::release(IndexT index) noexcept
+	{
+		NodeT& node = this->m_nodes[index];
+		node.m_value = ValueT{};
+		node.m_state = StateT::free;
+		++node.m_generation;
+		node.m_prev = npos;
+		node.m_next = this->m_free_head;
+		this->m_free_head = index;
+		--this->m_size;
+	}
+
+	template<class _TValue>
+	inline bool timing_wheel<_TValue>::link(IndexT index) noexcept
+	{
+		NodeT& node = this->m_nodes[index];
+		TickT tick = this->get_tick(node.m_time);
+		const bool due = tick <= this->m_current_tick;
+		if (due)
+			tick = this->m_current_tick + 1;
+
+		constexpr TickT range = (TickT)1 << (slots_bits * levels_num);
+		if (tick - this->m_current_tick >= range)
+			tick = this->m_current_tick + range - 1;
+
+		const TickT delta = tick - this->m_current_tick;
+		size_t level = 0;
+		while (delta >= ((TickT)1 << (slots_bits * (level + 1))))
+			++level;
+		const size_t slot = (size_t)(tick >> (slots_bits * level)) & (slots_num - 1);
+
+		LevelT& wheel = this->m_levels[level];
+		node.m_state = StateT::linked;
+		node.m_level = (::uint8_t)level;
+		node.m_slot = (::uint8_t)slot;
+		node.m_prev = npos;
+		node.m_next = wheel.m_heads[slot];
+		if (node.m_next != npos)
+			this->m_nodes[node.m_next].m_prev = index;
+		wheel.m_heads[slot] = index;
+		wheel.m_bitmap |= (SlotBitmapT)1 << slot;
+		return !due;
+	}
+
+	template<class _TValue>
+	inline void timing_wheel<_TValue>::unlink(IndexT index) noexcept
+	{
+		NodeT& node = this->m_nodes[index];
+		LevelT& wheel = this->m_levels[node.m_level];
+		if (node.m_prev != npos)
+			this->m_nodes[node.m_prev].m_next = node.m_next;
+		else
+			wheel.m_heads[node.m_slot] = node.m_next;
+		if (node.m_next != npos)
+			this->m_nodes[node.m_next].m_prev = node.m_prev;
+		if (wheel.m_heads[node.m_slot] == npos)
+			wheel.m_bitmap &= ~((SlotBitmapT)1 << node.m_slot);
+		node.m_state = StateT::detached;
+		node.m_prev = npos;
+		node.m_next = npos;
+	}
+
+	template<class _TValue>
+	template<class _TFunc>
+	inline void timing_wheel<_TValue>::fire(IndexT index, _TFunc& fire) noexcept
+	{
+		NodeT& node = this->m_nodes[index];
+		node.m_state = StateT::detached;
+		node.m_prev = npos;
+		node.m_next = npos;
+		switch (fire(IdT{ index, node.m_generation }, node.m_value))
+		{
+		case ActionT::rearm:
+			node.m_time += node.m_period;
+			this->link(index);
+			break;
+		case ActionT::detach:
+			break;
+		default:
+			this->release(index);
+			break;
+		}
+	}
+}